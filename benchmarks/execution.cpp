@@ -0,0 +1,48 @@
+#include "src/algorithms.hpp"
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Execution scaling benchmarks")
+{
+	using namespace geompp;
+
+	std::vector<Rect<int>> rects;
+	for (int i = 0; i < 500000; i++)
+		rects.push_back({(i * 37) % 4000, (i * 91) % 4000, 20 + i % 50, 20 + i % 30});
+	std::vector<Rect<int>> out(rects.size() * 4);
+
+	/* Thread counts double from 1 and always end with all the cores, even when
+	their number is not a power of two: 1, 2, 4, 6 on a 6-core machine. */
+
+	const std::size_t maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+	for (std::size_t threads = 1; threads <= maxThreads;
+	     threads = threads == maxThreads ? maxThreads + 1 : std::min(threads * 2, maxThreads))
+	{
+		ThreadPool pool(threads - 1);
+		const auto policy = execution::par.on(pool);
+
+		BENCHMARK("subtract, " + std::to_string(threads) + " thread(s)")
+		{
+			return subtract(policy, rects, Rect{1000, 1000, 2000, 2000}, out);
+		};
+
+		BENCHMARK("cull, " + std::to_string(threads) + " thread(s)")
+		{
+			return cull(policy, rects, Rect{1000, 1000, 2000, 2000}, out);
+		};
+
+		BENCHMARK("getHull, " + std::to_string(threads) + " thread(s)")
+		{
+			return getHull(policy, rects);
+		};
+
+		BENCHMARK("getUnionArea, " + std::to_string(threads) + " thread(s)")
+		{
+			return getUnionArea(policy, rects);
+		};
+	}
+}
@@ -0,0 +1,72 @@
+#include "src/fixed.hpp"
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+TEST_CASE("Fixed benchmarks")
+{
+	using namespace geompp;
+
+	using Fx   = Fixed<24, 8>;
+	using Fx16 = Fixed<8, 8>;
+
+	std::vector<Rect<float>> floatRects;
+	std::vector<Rect<Fx>>    rects;
+	std::vector<Rect<Fx16>>  rects16;
+	std::vector<Range<Fx>>   ranges;
+	std::vector<Range<Fx16>> ranges16;
+	for (int i = 0; i < 10000; i++)
+	{
+		const int x = (i * 37) % 100 - 50, y = (i * 91) % 100 - 50, w = 1 + i % 50, h = 1 + i % 30;
+		floatRects.push_back({float(x), float(y), float(w), float(h)});
+		rects.push_back({x, y, w, h});
+		rects16.push_back({x, y, w, h});
+		ranges.push_back({x, x + w});
+		ranges16.push_back({x, x + w});
+	}
+
+	/* Factors alternate between 0.5 and 2 so that the data, and the work done
+	on it, is the same on every run. */
+
+	int run = 0;
+
+	BENCHMARK("Rect<float>::scale")
+	{
+		const float factor = run++ % 2 ? 2.0f : 0.5f;
+		for (Rect<float>& r : floatRects)
+			r.scale(factor);
+		return floatRects[0];
+	};
+
+	BENCHMARK("Rect<Fixed<24, 8>>::scale")
+	{
+		const float factor = run++ % 2 ? 2.0f : 0.5f;
+		for (Rect<Fx>& r : rects)
+			r.scale(factor);
+		return rects[0];
+	};
+
+	BENCHMARK("scale Rect<Fixed<24, 8>>")
+	{
+		scale(rects, Fx(run++ % 2 ? 2.0 : 0.5));
+		return rects[0];
+	};
+
+	BENCHMARK("scale Rect<Fixed<8, 8>>")
+	{
+		scale(rects16, Fx16(run++ % 2 ? 2.0 : 0.5));
+		return rects16[0];
+	};
+
+	BENCHMARK("scale Range<Fixed<24, 8>>")
+	{
+		scale(ranges, Fx(run++ % 2 ? 2.0 : 0.5));
+		return ranges[0];
+	};
+
+	BENCHMARK("scale Range<Fixed<8, 8>>")
+	{
+		scale(ranges16, Fx16(run++ % 2 ? 2.0 : 0.5));
+		return ranges16[0];
+	};
+}
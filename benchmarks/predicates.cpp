@@ -0,0 +1,74 @@
+#include "src/predicates.hpp"
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+TEST_CASE("Predicates benchmarks")
+{
+	using namespace geompp;
+
+	std::mt19937                           rng(42);
+	std::uniform_real_distribution<double> dist(-1000, 1000);
+
+	std::uniform_int_distribution<std::int64_t> dist32(-(std::int64_t{1} << 31), std::int64_t{1} << 31);
+	std::uniform_int_distribution<std::int64_t> dist60(-(std::int64_t{1} << 60), std::int64_t{1} << 60);
+
+	std::vector<Point<double>>       random, degenerate;
+	std::vector<Point<std::int64_t>> random32, random60;
+	const double                     u = std::ldexp(1.0, -53);
+	for (int i = 0; i < 3000; i++)
+	{
+		random.push_back({dist(rng), dist(rng)});
+		degenerate.push_back({0.5 + (i % 32) * u, 0.5 + (i / 32 % 32) * u});
+		random32.push_back({dist32(rng), dist32(rng)});
+		random60.push_back({dist60(rng), dist60(rng)});
+	}
+
+	const auto naive = [](Point<double> a, Point<double> b, Point<double> c) {
+		const double det = (a.x - c.x) * (b.y - c.y) - (a.y - c.y) * (b.x - c.x);
+		return (det > 0) - (det < 0);
+	};
+
+	BENCHMARK("naive orientation, random")
+	{
+		int sum = 0;
+		for (std::size_t i = 2; i < random.size(); i++)
+			sum += naive(random[i - 2], random[i - 1], random[i]);
+		return sum;
+	};
+
+	BENCHMARK("orient2d, random")
+	{
+		int sum = 0;
+		for (std::size_t i = 2; i < random.size(); i++)
+			sum += orient2d(random[i - 2], random[i - 1], random[i]);
+		return sum;
+	};
+
+	BENCHMARK("orient2d, near-degenerate")
+	{
+		int sum = 0;
+		for (const Point<double>& p : degenerate)
+			sum += orient2d(p, Point<double>{12, 12}, Point<double>{24, 24});
+		return sum;
+	};
+
+	BENCHMARK("orient2d, random int64, 32 bits")
+	{
+		int sum = 0;
+		for (std::size_t i = 2; i < random32.size(); i++)
+			sum += orient2d(random32[i - 2], random32[i - 1], random32[i]);
+		return sum;
+	};
+
+	BENCHMARK("orient2d, random int64, 60 bits")
+	{
+		int sum = 0;
+		for (std::size_t i = 2; i < random60.size(); i++)
+			sum += orient2d(random60[i - 2], random60[i - 1], random60[i]);
+		return sum;
+	};
+}
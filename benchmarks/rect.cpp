@@ -0,0 +1,57 @@
+#include "src/algorithms.hpp"
+#include "src/rect.hpp"
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <span>
+#include <vector>
+
+TEST_CASE("Rect benchmarks")
+{
+	using namespace geompp;
+
+	std::vector<Rect<int>> rects;
+	for (int i = 0; i < 10000; i++)
+		rects.push_back({(i * 37) % 1000, (i * 91) % 1000, 20 + i % 50, 20 + i % 30});
+	std::vector<Rect<int>> out(rects.size() * 4);
+
+	BENCHMARK("subtract")
+	{
+		return subtract(rects, Rect{250, 250, 500, 500}, out);
+	};
+
+	/* getHull against the scalar loop it falls back to and against folding
+	getUnion(), which is what it replaces. The vector kernel kicks in for float
+	everywhere, for int only from SSE4.1. */
+
+	std::vector<Rect<float>> rectsf;
+	for (const Rect<int>& r : rects)
+		rectsf.push_back({static_cast<float>(r.x), static_cast<float>(r.y), static_cast<float>(r.w), static_cast<float>(r.h)});
+
+	BENCHMARK("getHull")
+	{
+		return getHull(execution::seq, rects);
+	};
+
+	BENCHMARK("getHull, scalar loop")
+	{
+		return detail::getHull(std::span<const Rect<int>>(rects));
+	};
+
+	BENCHMARK("getHull, float")
+	{
+		return getHull(execution::seq, rectsf);
+	};
+
+	BENCHMARK("getHull, float, scalar loop")
+	{
+		return detail::getHull(std::span<const Rect<float>>(rectsf));
+	};
+
+	BENCHMARK("getHull, getUnion fold")
+	{
+		Rect<int> hull;
+		for (const Rect<int>& r : rects)
+			hull = hull.getUnion(r);
+		return hull;
+	};
+}
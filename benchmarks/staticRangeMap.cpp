@@ -0,0 +1,81 @@
+#include "src/serialization.hpp"
+#include "src/staticRangeMap.hpp"
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+TEST_CASE("StaticRangeMap benchmarks")
+{
+	using namespace geompp;
+
+	std::vector<Range<std::int64_t>> ranges;
+	for (std::int64_t i = 0; i < 1000000; i++)
+		ranges.push_back({i * 512, i * 512 + 500});
+
+	std::mt19937_64                             rng(42);
+	std::uniform_int_distribution<std::int64_t> dist(0, ranges.back().getB());
+	std::vector<std::int64_t>                   queries(100000);
+	for (std::int64_t& q : queries)
+		q = dist(rng);
+
+	const StaticRangeMap<std::int64_t> map(ranges);
+
+	BENCHMARK("std::upper_bound")
+	{
+		std::size_t found = 0;
+		for (const std::int64_t q : queries)
+		{
+			const auto it = std::upper_bound(ranges.begin(), ranges.end(), q,
+			    [](std::int64_t t, const Range<std::int64_t>& r) { return t < r.getA(); });
+			found += it != ranges.begin() && (it - 1)->contains(q);
+		}
+		return found;
+	};
+
+	BENCHMARK("StaticRangeMap::findIndex")
+	{
+		std::size_t found = 0;
+		for (const std::int64_t q : queries)
+			found += map.findIndex(q) != StaticRangeMap<std::int64_t>::npos;
+		return found;
+	};
+
+	/* The serialized map, in a buffer aligned like a memory-mapped file. */
+
+	const std::size_t      blobSize = getBinarySize(map);
+	std::vector<std::byte> storage(blobSize + detail::CACHE_LINE);
+	void*                  aligned = storage.data();
+	std::size_t            space   = storage.size();
+	std::align(detail::CACHE_LINE, blobSize, aligned, space);
+	const std::span<std::byte> blob(static_cast<std::byte*>(aligned), blobSize);
+	writeBinary(map, blob);
+
+	BENCHMARK("StaticRangeMapView open")
+	{
+		return StaticRangeMapView<std::int64_t>(blob).size();
+	};
+
+	BENCHMARK("StaticRangeMapView::findIndex")
+	{
+		const StaticRangeMapView<std::int64_t> view(blob);
+
+		std::size_t found = 0;
+		for (const std::int64_t q : queries)
+			found += view.findIndex(q) != StaticRangeMapView<std::int64_t>::npos;
+		return found;
+	};
+
+	BENCHMARK("StaticRangeMap build")
+	{
+		return StaticRangeMap<std::int64_t>(ranges).size();
+	};
+
+	BENCHMARK("StaticRangeMap build, par")
+	{
+		return StaticRangeMap<std::int64_t>(execution::par, ranges).size();
+	};
+}
@@ -0,0 +1,807 @@
+/* -----------------------------------------------------------------------------
+ *
+ * geompp - Basic geometrical utilities for C++.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2021 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of geompp - Basic geometrical utilities for C++.
+ *
+ * geompp - Basic geometrical utilities for C++ is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * geompp - Basic geometrical utilities for C++ is distributed in the hope that
+ * it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with geompp - Basic geometrical utilities for C++. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef GEOMPP_ALGORITHMS_HH
+#define GEOMPP_ALGORITHMS_HH
+
+#include "execution.hpp"
+#include "fixed.hpp"
+#include "range.hpp"
+#include "rect.hpp"
+#include "stats.hpp"
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <type_traits>
+#include <vector>
+
+/* Span algorithms
+Batch operations and reductions over contiguous collections of geometry types.
+Each one takes an execution policy (execution::seq, par or par_unseq) as first
+argument; algorithms that produce a variable number of results write them into
+a caller-provided buffer and return how many were written. */
+
+/* GEOMPP_VECTOR_EXTENSIONS
+Enables the kernels written with GCC vector extensions. Clang has the vector
+types but not the lane-wise ?: used here, so it gets the plain loops. Define it
+to 0 to force them on GCC too. */
+
+#ifndef GEOMPP_VECTOR_EXTENSIONS
+#if defined(__GNUC__) && !defined(__clang__)
+#define GEOMPP_VECTOR_EXTENSIONS 1
+#else
+#define GEOMPP_VECTOR_EXTENSIONS 0
+#endif
+#endif
+
+namespace geompp
+{
+namespace detail
+{
+/* compact
+Calls emit(i, dst) for each of the 'count' inputs, where emit writes up to
+MaxOut results to dst and returns how many it wrote, and packs all results into
+'out' in input order. The parallel version runs emit twice per input: once to
+count the results of each chunk, once to write them at their final offset. */
+
+template <std::size_t MaxOut, typename Policy, typename T, typename Emit>
+std::size_t compact(const Policy& policy, std::size_t count, std::span<T> out, Emit emit)
+{
+	if constexpr (!execution::isParallel<Policy>)
+	{
+		std::size_t written = 0;
+		for (std::size_t i = 0; i < count; i++)
+		{
+			assert(written + MaxOut <= out.size());
+			written += emit(i, out.data() + written);
+		}
+		return written;
+	}
+	else
+	{
+		const std::size_t grain  = getGrain(policy, count);
+		const std::size_t chunks = (count + grain - 1) / grain;
+
+		GEOMPP_STATS_ADD(allocations, 1);
+		std::vector<std::size_t> offsets(chunks + 1, 0);
+
+		forEachChunk(policy, count, [&](std::size_t begin, std::size_t end) {
+			T           scratch[MaxOut];
+			std::size_t n = 0;
+			for (std::size_t i = begin; i < end; i++)
+				n += emit(i, scratch);
+			offsets[begin / grain + 1] = n;
+		});
+
+		std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+		assert(offsets.back() <= out.size());
+
+		forEachChunk(policy, count, [&](std::size_t begin, std::size_t end) {
+			T* dst = out.data() + offsets[begin / grain];
+			for (std::size_t i = begin; i < end; i++)
+				dst += emit(i, dst);
+		});
+
+		return offsets.back();
+	}
+}
+
+/* bucket
+Clips each of the 'count' inputs to the slabs it overlaps and groups the
+pieces by slab, in one buffer where slab s is [starts[s], starts[s + 1]).
+Slab s spans [bounds[s], bounds[s + 1]). extent(i) returns the span of input
+i along the slab axis, invalid to skip it; clip(i, slab) returns its piece
+inside 'slab', or an invalid piece if there is none. Like compact(), this
+counts the pieces of each chunk first and then writes them at their final
+offset, so the inputs are read twice in total whatever the number of slabs. */
+
+template <typename Piece, typename Policy, typename T, typename Extent, typename Clip>
+std::vector<Piece> bucket(const Policy& policy, std::size_t count, std::span<const T> bounds,
+    std::vector<std::size_t>& starts, Extent extent, Clip clip)
+{
+	const std::size_t slabs  = bounds.size() - 1;
+	const std::size_t grain  = getGrain(policy, count);
+	const std::size_t chunks = (count + grain - 1) / grain;
+
+	/* Calls fn(slab, piece) for each valid piece of input i. */
+
+	const auto forEachPiece = [&](std::size_t i, auto fn) {
+		const Range<T> e = extent(i);
+		if (!e.isValid())
+			return;
+		const auto first = std::upper_bound(bounds.begin(), bounds.end(), e.getA()) - bounds.begin() - 1;
+		const auto last  = std::lower_bound(bounds.begin(), bounds.end(), e.getB()) - bounds.begin();
+		for (auto s = std::max<std::ptrdiff_t>(first, 0); s < last; s++)
+		{
+			if (bounds[s] >= bounds[s + 1])
+				continue;
+			if (const Piece piece = clip(i, Range<T>(bounds[s], bounds[s + 1])); piece.isValid())
+				fn(static_cast<std::size_t>(s), piece);
+		}
+	};
+
+	/* offsets[c * slabs + s] counts the pieces of chunk c in slab s, then
+	becomes where chunk c writes its first one. */
+
+	GEOMPP_STATS_ADD(allocations, 1);
+	std::vector<std::size_t> offsets(chunks * slabs, 0);
+
+	forEachChunk(policy, count, [&](std::size_t begin, std::size_t end) {
+		std::size_t* n = offsets.data() + begin / grain * slabs;
+		for (std::size_t i = begin; i < end; i++)
+			forEachPiece(i, [n](std::size_t s, const Piece&) { n[s]++; });
+	});
+
+	GEOMPP_STATS_ADD(allocations, 1);
+	starts.assign(slabs + 1, 0);
+
+	std::size_t total = 0;
+	for (std::size_t s = 0; s < slabs; s++)
+	{
+		starts[s] = total;
+		for (std::size_t c = 0; c < chunks; c++)
+			total += std::exchange(offsets[c * slabs + s], total);
+	}
+	starts[slabs] = total;
+
+	GEOMPP_STATS_ADD(allocations, 1);
+	std::vector<Piece> out(total);
+
+	forEachChunk(policy, count, [&](std::size_t begin, std::size_t end) {
+		std::size_t* next = offsets.data() + begin / grain * slabs;
+		for (std::size_t i = begin; i < end; i++)
+			forEachPiece(i, [&](std::size_t s, const Piece& piece) { out[next[s]++] = piece; });
+	});
+
+	return out;
+}
+
+/* reduce
+Calls chunkFn(begin, end) on chunks of [0, count) and folds the results with
+'combine', starting from 'identity'. */
+
+template <typename Policy, typename R, typename ChunkFn, typename Combine>
+R reduce(const Policy& policy, std::size_t count, R identity, ChunkFn chunkFn, Combine combine)
+{
+	if (count == 0)
+		return identity;
+
+	if constexpr (!execution::isParallel<Policy>)
+		return combine(identity, chunkFn(0, count));
+	else
+	{
+		const std::size_t grain = getGrain(policy, count);
+
+		GEOMPP_STATS_ADD(allocations, 1);
+		std::vector<R> partials((count + grain - 1) / grain, identity);
+
+		forEachChunk(policy, count, [&](std::size_t begin, std::size_t end) {
+			partials[begin / grain] = chunkFn(begin, end);
+		});
+
+		R out = identity;
+		for (const R& p : partials)
+			out = combine(out, p);
+		return out;
+	}
+}
+
+/* forEachSlab
+Calls fn(i) for each i in [0, slabs), one slab per task. */
+
+template <typename Policy, typename F>
+void forEachSlab(const Policy& policy, std::size_t slabs, F fn)
+{
+	forEachChunk(policy.withGrain(1), slabs, [&](std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; i++)
+			fn(i);
+	});
+}
+
+/* getSlabs
+Number of slabs to split a sweep in, for the parallel policies. */
+
+template <typename Policy>
+std::size_t getSlabs(const Policy& policy)
+{
+	return policy.getPool().getConcurrency() * 4;
+}
+
+/* getSlabBoundary
+Boundary i of 'slabs' equal slabs over [start, start + length). */
+
+template <typename Area, typename T>
+T getSlabBoundary(T start, T length, std::size_t i, std::size_t slabs)
+{
+	if (i == slabs)
+		return start + length;
+	return static_cast<T>(start + static_cast<Area>(length) * static_cast<Area>(i) / static_cast<Area>(slabs));
+}
+
+/* getSweptLength
+Total length covered by 'ranges', overlaps counted once. Sorts 'ranges'. */
+
+template <typename T>
+T getSweptLength(std::span<Range<T>> ranges)
+{
+	std::sort(ranges.begin(), ranges.end(), [](const Range<T>& l, const Range<T>& r) { return l.getA() < r.getA(); });
+
+	T length = 0;
+	T start  = 0;
+	T end    = 0;
+	for (std::size_t i = 0; i < ranges.size(); i++)
+	{
+		if (i == 0 || ranges[i].getA() > end)
+		{
+			length += end - start;
+			start = ranges[i].getA();
+			end   = ranges[i].getB();
+		}
+		else
+			end = std::max(end, ranges[i].getB());
+	}
+	return length + (end - start);
+}
+
+/* CoverTree
+Segment tree over the elementary intervals between sorted coordinates 'ys',
+tracking how much of them is covered by at least one interval. */
+
+template <typename T, typename Area>
+class CoverTree
+{
+public:
+	CoverTree(const std::vector<T>& ys)
+	: ys(ys)
+	, counts(4 * ys.size(), 0)
+	, lengths(4 * ys.size(), 0)
+	{
+	}
+
+	/* update
+	Adds 'delta' to the cover count of the coordinates in [y1, y2). */
+
+	void update(T y1, T y2, int delta)
+	{
+		const std::size_t l = std::lower_bound(ys.begin(), ys.end(), y1) - ys.begin();
+		const std::size_t r = std::lower_bound(ys.begin(), ys.end(), y2) - ys.begin();
+		update(1, 0, ys.size() - 1, l, r, delta);
+	}
+
+	Area getCovered() const { return lengths[1]; }
+
+private:
+	void update(std::size_t node, std::size_t l, std::size_t r, std::size_t ql, std::size_t qr, int delta)
+	{
+		if (qr <= l || r <= ql)
+			return;
+
+		if (ql <= l && r <= qr)
+			counts[node] += delta;
+		else
+		{
+			const std::size_t mid = (l + r) / 2;
+			update(2 * node, l, mid, ql, qr, delta);
+			update(2 * node + 1, mid, r, ql, qr, delta);
+		}
+
+		if (counts[node] > 0)
+			lengths[node] = static_cast<Area>(ys[r]) - static_cast<Area>(ys[l]);
+		else
+			lengths[node] = r - l == 1 ? 0 : lengths[2 * node] + lengths[2 * node + 1];
+	}
+
+	const std::vector<T>& ys;
+	std::vector<int>      counts;
+	std::vector<Area>     lengths;
+};
+
+/* getSweptArea
+Area covered by 'rects', overlaps counted once, with a sweep along the x axis
+over a CoverTree of the y coordinates. */
+
+template <typename T, typename Area>
+Area getSweptArea(std::span<const Rect<T>> rects)
+{
+	if (rects.empty())
+		return 0;
+
+	struct Event
+	{
+		T   x;
+		T   y1, y2;
+		int delta;
+	};
+
+	std::vector<Event> events;
+	std::vector<T>     ys;
+	events.reserve(rects.size() * 2);
+	ys.reserve(rects.size() * 2);
+	for (const Rect<T>& r : rects)
+	{
+		events.push_back({r.x, r.y, r.y + r.h, 1});
+		events.push_back({r.x + r.w, r.y, r.y + r.h, -1});
+		ys.push_back(r.y);
+		ys.push_back(r.y + r.h);
+	}
+	std::sort(events.begin(), events.end(), [](const Event& l, const Event& r) { return l.x < r.x; });
+	std::sort(ys.begin(), ys.end());
+	ys.erase(std::unique(ys.begin(), ys.end()), ys.end());
+
+	CoverTree<T, Area> tree(ys);
+	Area               area = 0;
+	T                  prev = events.front().x;
+	for (const Event& e : events)
+	{
+		area += tree.getCovered() * (static_cast<Area>(e.x) - static_cast<Area>(prev));
+		tree.update(e.y1, e.y2, e.delta);
+		prev = e.x;
+	}
+	return area;
+}
+
+/* getHull (1)
+Bounding box of the valid Rects in 'rects', or an invalid Rect if there are
+none. Starts from the first valid Rect rather than from sentinels, which not
+every T has, and selects values instead of branching in the loop that follows.
+GCC can't vectorize it though: six-field Rects are too wide for its load
+permutations. See getHullOfValid() below. */
+
+template <typename T>
+Rect<T> getHull(std::span<const Rect<T>> rects)
+{
+	const auto first = std::find_if(rects.begin(), rects.end(), [](const Rect<T>& r) { return r.isValid(); });
+	if (first == rects.end())
+		return {};
+
+	const Rect<T>& seed = *first;
+
+	T x1 = seed.x, y1 = seed.y, x2 = seed.xw, y2 = seed.yh;
+	for (auto it = first + 1; it != rects.end(); ++it)
+	{
+		const bool valid = it->isValid();
+		const T    x     = valid ? it->x : seed.x;
+		const T    y     = valid ? it->y : seed.y;
+		const T    xw    = valid ? it->xw : seed.xw;
+		const T    yh    = valid ? it->yh : seed.yh;
+		x1               = x < x1 ? x : x1;
+		y1               = y < y1 ? y : y1;
+		x2               = xw > x2 ? xw : x2;
+		y2               = yh > y2 ? yh : y2;
+	}
+	return Rect<T>(x1, y1, x2 - x1, y2 - y1);
+}
+
+/* getHull (2)
+Same as above, for Ranges. This loop does vectorize. */
+
+template <typename T>
+Range<T> getHull(std::span<const Range<T>> ranges)
+{
+	const auto first = std::find_if(ranges.begin(), ranges.end(), [](const Range<T>& r) { return r.isValid(); });
+	if (first == ranges.end())
+		return {};
+
+	const T seedA = first->getA(), seedB = first->getB();
+
+	T a = seedA, b = seedB;
+	for (auto it = first + 1; it != ranges.end(); ++it)
+	{
+		const bool valid = it->isValid();
+		const T    ra    = valid ? it->getA() : seedA;
+		const T    rb    = valid ? it->getB() : seedB;
+		a                = ra < a ? ra : a;
+		b                = rb > b ? rb : b;
+	}
+	return Range<T>(a, b);
+}
+
+#if GEOMPP_VECTOR_EXTENSIONS
+
+/* HasVectorHull
+Scalars that getHullOfValid() works with: 32-bit numbers, so that two Rects
+fill three 16-byte vectors. Integers only where the target has vector integer
+min and max: plain SSE2 has to emulate them, and there the scalar loop wins. */
+
+#if defined(__SSE4_1__) || defined(__ARM_NEON)
+inline constexpr bool VECTOR_INT_MINMAX = true;
+#else
+inline constexpr bool VECTOR_INT_MINMAX = false;
+#endif
+
+template <typename T>
+concept HasVectorHull = (std::floating_point<T> || (std::integral<T> && VECTOR_INT_MINMAX)) &&
+                        sizeof(T) == 4 && sizeof(Rect<T>) == 6 * sizeof(T) && std::is_trivially_copyable_v<Rect<T>>;
+
+/* getHullOfValid
+getHull() for the common case where all Rects are valid, written with GCC
+vector extensions. Loads the raw fields of two Rects at a time into three
+vectors and keeps their lane-wise min and max, so that lanes end up holding
+the smallest x, y, w, h and the largest xw, yh of either Rect in the pair.
+Returns an invalid Rect when some Rect is invalid (the smallest w or h is not
+positive) or there are fewer than two, for the caller to fall back to
+getHull(). */
+
+template <HasVectorHull T>
+Rect<T> getHullOfValid(std::span<const Rect<T>> rects)
+{
+	typedef T Lanes __attribute__((vector_size(16)));
+
+	const std::size_t count = rects.size();
+	if (count < 2)
+		return {};
+
+	const char* bytes = reinterpret_cast<const char*>(rects.data());
+	const auto  load  = [bytes](std::size_t offset) {
+		Lanes v;
+		std::memcpy(&v, bytes + offset, sizeof(Lanes));
+		return v;
+	};
+
+	/* Lanes of each vector: {x, y, w, h}, {xw, yh, x, y}, {w, h, xw, yh}. */
+
+	Lanes lo0 = load(0), lo1 = load(sizeof(Lanes)), lo2 = load(2 * sizeof(Lanes));
+	Lanes hi0 = lo0, hi1 = lo1, hi2 = lo2;
+
+	std::size_t i = 2;
+	for (; i + 1 < count; i += 2)
+	{
+		const std::size_t offset = i * sizeof(Rect<T>);
+		const Lanes       v0     = load(offset);
+		const Lanes       v1     = load(offset + sizeof(Lanes));
+		const Lanes       v2     = load(offset + 2 * sizeof(Lanes));
+		lo0                      = v0 < lo0 ? v0 : lo0;
+		lo1                      = v1 < lo1 ? v1 : lo1;
+		lo2                      = v2 < lo2 ? v2 : lo2;
+		hi0                      = v0 > hi0 ? v0 : hi0;
+		hi1                      = v1 > hi1 ? v1 : hi1;
+		hi2                      = v2 > hi2 ? v2 : hi2;
+	}
+
+	T x1 = std::min(lo0[0], lo1[2]), y1 = std::min(lo0[1], lo1[3]);
+	T x2 = std::max(hi1[0], hi2[2]), y2 = std::max(hi1[1], hi2[3]);
+	T w  = std::min(lo0[2], lo2[0]), h = std::min(lo0[3], lo2[1]);
+	if (i < count)
+	{
+		const Rect<T>& r = rects[i];
+		x1               = std::min(x1, r.x);
+		y1               = std::min(y1, r.y);
+		x2               = std::max(x2, r.xw);
+		y2               = std::max(y2, r.yh);
+		w                = std::min(w, r.w);
+		h                = std::min(h, r.h);
+	}
+
+	if (!(w > 0 && h > 0))
+		return {};
+	return Rect<T>(x1, y1, x2 - x1, y2 - y1);
+}
+#endif
+} // namespace detail
+
+/* ContiguousRangeOf
+A contiguous container (vector, array, span...) of G<T>, e.g. Rect<T>. Not to
+be confused with geompp's Range. */
+
+namespace detail
+{
+template <typename V, template <typename> typename G>
+struct InstanceOf : std::false_type
+{
+};
+
+template <typename T, template <typename> typename G>
+struct InstanceOf<G<T>, G> : std::true_type
+{
+};
+
+template <typename V>
+struct ScalarOf;
+
+template <typename T, template <typename> typename G>
+struct ScalarOf<G<T>>
+{
+	using type = T;
+};
+} // namespace detail
+
+template <typename C, template <typename> typename G>
+concept ContiguousRangeOf = std::ranges::contiguous_range<C> &&
+                            detail::InstanceOf<std::ranges::range_value_t<C>, G>::value;
+
+/* ContiguousRangeScalar
+The T of the G<T> elements in container C. */
+
+template <typename C>
+using ContiguousRangeScalar = typename detail::ScalarOf<std::ranges::range_value_t<C>>::type;
+
+/* RectArea
+Type used for areas of Rect<T>: 64-bit integers for integral T, double
+otherwise. */
+
+template <typename T>
+using RectArea = std::conditional_t<std::is_integral_v<T>, std::int64_t, double>;
+
+/* transform
+Writes fn(in[i]) into out[i] for every element of 'in'. 'out' must be at least
+as large as 'in'. */
+
+template <typename Policy, std::ranges::contiguous_range In, std::ranges::contiguous_range Out, typename F>
+void transform(const Policy& policy, const In& in, Out&& out, F fn)
+{
+	assert(std::ranges::size(out) >= std::ranges::size(in));
+
+	const auto* src = std::ranges::data(in);
+	auto*       dst = std::ranges::data(out);
+	detail::forEachChunk(policy, std::ranges::size(in), [&](std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; i++)
+			dst[i] = fn(src[i]);
+	});
+}
+
+/* cull
+Writes the Rects that intersect 'viewport' into 'out', keeping their order.
+Returns the number of Rects written. 'out' must be as large as 'rects'. */
+
+template <typename Policy, typename T>
+std::size_t cull(const Policy& policy, std::type_identity_t<std::span<const Rect<T>>> rects,
+    const Rect<T>& viewport, std::type_identity_t<std::span<Rect<T>>> out)
+{
+	GEOMPP_TRACE_SCOPE("geompp::cull");
+	GEOMPP_STATS_ADD(candidatesTested, rects.size());
+
+	return detail::compact<1>(policy, rects.size(), out, [&](std::size_t i, Rect<T>* dst) -> std::size_t {
+		if (!rects[i].intersects(viewport))
+			return 0;
+		*dst = rects[i];
+		return 1;
+	});
+}
+
+/* subtract
+Policy-aware version of subtract() from rect.hpp. */
+
+template <typename Policy, typename T>
+std::size_t subtract(const Policy& policy, std::type_identity_t<std::span<const Rect<T>>> rects,
+    const Rect<T>& o, std::type_identity_t<std::span<Rect<T>>> out)
+{
+	if constexpr (!execution::isParallel<Policy>)
+		return subtract(rects, o, out);
+	else
+	{
+		GEOMPP_TRACE_SCOPE("geompp::subtract");
+		GEOMPP_STATS_ADD(candidatesTested, rects.size());
+
+		return detail::compact<4>(policy, rects.size(), out, [&](std::size_t i, Rect<T>* dst) {
+			std::size_t n = 0;
+			for (const Rect<T>& piece : rects[i].getDifference(o))
+				if (piece.isValid())
+					dst[n++] = piece;
+			return n;
+		});
+	}
+}
+
+/* scale
+Policy-aware versions of the fixed-point scale() from fixed.hpp. */
+
+template <Rounding R = Rounding::NEAREST, typename Policy, int I, int F>
+void scale(const Policy& policy, std::type_identity_t<std::span<Range<Fixed<I, F>>>> ranges, Fixed<I, F> factor)
+{
+	detail::forEachChunk(policy, ranges.size(), [&](std::size_t begin, std::size_t end) {
+		scale<R>(ranges.subspan(begin, end - begin), factor);
+	});
+}
+
+template <Rounding R = Rounding::NEAREST, typename Policy, int I, int F>
+void scale(const Policy& policy, std::type_identity_t<std::span<Rect<Fixed<I, F>>>> rects, Fixed<I, F> factor)
+{
+	detail::forEachChunk(policy, rects.size(), [&](std::size_t begin, std::size_t end) {
+		scale<R>(rects.subspan(begin, end - begin), factor);
+	});
+}
+
+/* getHull
+Returns the bounding box of all valid Rects, or an invalid Rect if there are
+none. */
+
+template <typename Policy, ContiguousRangeOf<Rect> C>
+auto getHull(const Policy& policy, const C& items)
+{
+	using T = ContiguousRangeScalar<C>;
+	const std::span<const Rect<T>> rects(items);
+
+	GEOMPP_TRACE_SCOPE("geompp::getHull");
+
+	return detail::reduce(
+	    policy, rects.size(), Rect<T>(),
+	    [&](std::size_t begin, std::size_t end) {
+		    const std::span<const Rect<T>> chunk = rects.subspan(begin, end - begin);
+#if GEOMPP_VECTOR_EXTENSIONS
+		    if constexpr (detail::HasVectorHull<T>)
+			    if (const Rect<T> hull = detail::getHullOfValid(chunk); hull.isValid())
+			    {
+				    GEOMPP_STATS_ADD(simdPaths, 1);
+				    return hull;
+			    }
+#endif
+		    GEOMPP_STATS_ADD(scalarPaths, 1);
+		    return detail::getHull(chunk);
+	    },
+	    [](const Rect<T>& l, const Rect<T>& r) { return l.getUnion(r); });
+}
+
+/* getHull
+Same as above, for Ranges. */
+
+template <typename Policy, ContiguousRangeOf<Range> C>
+auto getHull(const Policy& policy, const C& items)
+{
+	using T = ContiguousRangeScalar<C>;
+	const std::span<const Range<T>> ranges(items);
+
+	return detail::reduce(
+	    policy, ranges.size(), Range<T>(),
+	    [&](std::size_t begin, std::size_t end) { return detail::getHull(ranges.subspan(begin, end - begin)); },
+	    [](const Range<T>& l, const Range<T>& r) { return l.getUnion(r); });
+}
+
+namespace detail
+{
+/* getSlabBounds
+Boundaries of 'slabs' equal slabs over 'hull'. */
+
+template <typename T>
+std::vector<T> getSlabBounds(Range<T> hull, std::size_t slabs)
+{
+	GEOMPP_STATS_ADD(allocations, 1);
+	std::vector<T> bounds(slabs + 1);
+	for (std::size_t i = 0; i <= slabs; i++)
+		bounds[i] = getSlabBoundary<RectArea<T>>(hull.getA(), hull.getLength(), i, slabs);
+	return bounds;
+}
+} // namespace detail
+
+/* getCoveredLength
+Returns the total length covered by 'ranges', counting overlapping parts once.
+Sorts a copy of the valid Ranges and sweeps it. The parallel version splits the
+hull in slabs, buckets the Ranges by slab and sweeps each slab on its own. */
+
+template <typename Policy, ContiguousRangeOf<Range> C>
+auto getCoveredLength(const Policy& policy, const C& items)
+{
+	using T = ContiguousRangeScalar<C>;
+	const std::span<const Range<T>> ranges(items);
+
+	GEOMPP_TRACE_SCOPE("geompp::getCoveredLength");
+
+	const auto collect = [&](Range<T> clip) {
+		GEOMPP_STATS_ADD(allocations, 1);
+		std::vector<Range<T>> out;
+		for (const Range<T>& r : ranges)
+		{
+			const T a = std::max(r.getA(), clip.getA());
+			const T b = std::min(r.getB(), clip.getB());
+			if (r.isValid() && a < b)
+				out.push_back({a, b});
+		}
+		return out;
+	};
+
+	const Range<T> hull = getHull(execution::seq, ranges);
+	if (!hull.isValid())
+		return T{0};
+
+	if constexpr (!execution::isParallel<Policy>)
+	{
+		std::vector<Range<T>> valid = collect(hull);
+		return detail::getSweptLength<T>(valid);
+	}
+	else
+	{
+		const std::size_t        slabs  = detail::getSlabs(policy);
+		const std::vector<T>     bounds = detail::getSlabBounds(hull, slabs);
+		std::vector<std::size_t> starts;
+		std::vector<Range<T>>    pieces = detail::bucket<Range<T>>(
+		    policy, ranges.size(), std::span<const T>(bounds), starts,
+		    [&](std::size_t i) { return ranges[i]; },
+		    [&](std::size_t i, Range<T> slab) {
+			    const T a = std::max(ranges[i].getA(), slab.getA());
+			    const T b = std::min(ranges[i].getB(), slab.getB());
+			    return a < b ? Range<T>(a, b) : Range<T>();
+		    });
+
+		GEOMPP_STATS_ADD(allocations, 1);
+		std::vector<T> lengths(slabs, 0);
+
+		detail::forEachSlab(policy, slabs, [&](std::size_t i) {
+			lengths[i] = detail::getSweptLength(std::span(pieces).subspan(starts[i], starts[i + 1] - starts[i]));
+		});
+
+		return std::accumulate(lengths.begin(), lengths.end(), T{0});
+	}
+}
+
+/* getUnionArea
+Returns the area covered by 'rects', counting overlapping parts once, with a
+sweep line over a segment tree. The parallel version splits the hull in
+vertical slabs, buckets the Rects by slab and sweeps each slab on its own. */
+
+template <typename Policy, ContiguousRangeOf<Rect> C>
+auto getUnionArea(const Policy& policy, const C& items)
+{
+	using T = ContiguousRangeScalar<C>;
+	const std::span<const Rect<T>> rects(items);
+
+	GEOMPP_TRACE_SCOPE("geompp::getUnionArea");
+
+	const auto collect = [&](const Rect<T>& clip) {
+		GEOMPP_STATS_ADD(allocations, 1);
+		std::vector<Rect<T>> out;
+		for (const Rect<T>& r : rects)
+			if (r.isValid() && r.intersects(clip))
+				out.push_back(r.getIntersection(clip));
+		return out;
+	};
+
+	const Rect<T> hull = getHull(execution::seq, rects);
+	if (!hull.isValid())
+		return RectArea<T>{0};
+
+	if constexpr (!execution::isParallel<Policy>)
+		return detail::getSweptArea<T, RectArea<T>>(collect(hull));
+	else
+	{
+		const std::size_t          slabs  = detail::getSlabs(policy);
+		const std::vector<T>       bounds = detail::getSlabBounds(hull.getWidthAsRange(), slabs);
+		std::vector<std::size_t>   starts;
+		const std::vector<Rect<T>> pieces = detail::bucket<Rect<T>>(
+		    policy, rects.size(), std::span<const T>(bounds), starts,
+		    [&](std::size_t i) { return rects[i].isValid() ? rects[i].getWidthAsRange() : Range<T>(); },
+		    [&](std::size_t i, Range<T> slab) {
+			    return rects[i].getIntersection({slab.getA(), hull.y, slab.getLength(), hull.h});
+		    });
+
+		GEOMPP_STATS_ADD(allocations, 1);
+		std::vector<RectArea<T>> areas(slabs, 0);
+
+		detail::forEachSlab(policy, slabs, [&](std::size_t i) {
+			areas[i] = detail::getSweptArea<T, RectArea<T>>(std::span(pieces).subspan(starts[i], starts[i + 1] - starts[i]));
+		});
+
+		return std::accumulate(areas.begin(), areas.end(), RectArea<T>{0});
+	}
+}
+} // namespace geompp
+
+#endif
@@ -0,0 +1,344 @@
+/* -----------------------------------------------------------------------------
+ *
+ * geompp - Basic geometrical utilities for C++.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2021 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of geompp - Basic geometrical utilities for C++.
+ *
+ * geompp - Basic geometrical utilities for C++ is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * geompp - Basic geometrical utilities for C++ is distributed in the hope that
+ * it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with geompp - Basic geometrical utilities for C++. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef GEOMPP_EXECUTION_HH
+#define GEOMPP_EXECUTION_HH
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace geompp
+{
+/* ThreadPool
+Small work-stealing thread pool backing the parallel execution policies. Each
+parallelFor() splits the work in chunks, deals them out to one queue per
+thread and lets idle threads steal from the back of the others' queues. The
+calling thread takes part in the work too. Calls from inside a running task,
+or on a pool without workers, run sequentially on the calling thread. */
+
+class ThreadPool
+{
+public:
+	/* ThreadPool (1)
+	One worker per hardware thread, minus the calling one. */
+
+	ThreadPool()
+	: ThreadPool(std::max(std::thread::hardware_concurrency(), 1u) - 1)
+	{
+	}
+
+	/* ThreadPool (2)
+	Pool with 'workers' threads besides the calling one. If the system can't
+	create all of them, the pool runs with the ones it got. */
+
+	explicit ThreadPool(std::size_t workers)
+	{
+		for (std::size_t i = 0; i < workers; i++)
+		{
+			try
+			{
+				threads.emplace_back([this, i] { run(i + 1); });
+			}
+			catch (const std::system_error&)
+			{
+				break;
+			}
+		}
+	}
+
+	ThreadPool(const ThreadPool&)            = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	~ThreadPool()
+	{
+		{
+			std::scoped_lock lock(mutex);
+			stopping = true;
+		}
+		wakeUp.notify_all();
+		for (std::thread& t : threads)
+			t.join();
+	}
+
+	/* getConcurrency
+	Number of threads that take part in a parallelFor(), caller included. */
+
+	std::size_t getConcurrency() const { return threads.size() + 1; }
+
+	/* parallelFor
+	Calls fn(begin, end) over [0, count) in chunks of 'grain' elements. Chunk
+	boundaries are always multiples of 'grain'. The first exception thrown by
+	'fn' is rethrown here once all threads are done. */
+
+	void parallelFor(std::size_t count, std::size_t grain, const std::function<void(std::size_t, std::size_t)>& fn)
+	{
+		if (count == 0)
+			return;
+
+		grain                  = std::max<std::size_t>(grain, 1);
+		const std::size_t jobs = (count + grain - 1) / grain;
+
+		if (threads.empty() || jobs == 1 || isInsideTask())
+		{
+			fn(0, count);
+			return;
+		}
+
+		std::scoped_lock jobLock(jobMutex);
+
+		Job job(fn, count, grain, jobs, getConcurrency());
+		{
+			std::scoped_lock lock(mutex);
+			currentJob = &job;
+			generation++;
+		}
+		wakeUp.notify_all();
+
+		work(job, 0);
+
+		std::unique_lock lock(mutex);
+		done.wait(lock, [this] { return finishedWorkers == threads.size(); });
+		finishedWorkers = 0;
+		currentJob      = nullptr;
+		lock.unlock();
+
+		if (job.exception)
+			std::rethrow_exception(job.exception);
+	}
+
+private:
+	/* Queue
+	Contiguous range of chunk indexes. The owner pops from the front, thieves
+	steal from the back. */
+
+	struct Queue
+	{
+		std::optional<std::size_t> pop()
+		{
+			std::scoped_lock lock(mutex);
+			if (front == back)
+				return {};
+			return front++;
+		}
+
+		std::optional<std::size_t> steal()
+		{
+			std::scoped_lock lock(mutex);
+			if (front == back)
+				return {};
+			return --back;
+		}
+
+		std::mutex  mutex;
+		std::size_t front = 0;
+		std::size_t back  = 0;
+	};
+
+	struct Job
+	{
+		Job(const std::function<void(std::size_t, std::size_t)>& fn, std::size_t count,
+		    std::size_t grain, std::size_t chunks, std::size_t participants)
+		: fn(fn)
+		, count(count)
+		, grain(grain)
+		, participants(participants)
+		, queues(std::make_unique<Queue[]>(participants))
+		{
+			for (std::size_t i = 0; i < participants; i++)
+			{
+				queues[i].front = chunks * i / participants;
+				queues[i].back  = chunks * (i + 1) / participants;
+			}
+		}
+
+		const std::function<void(std::size_t, std::size_t)>& fn;
+		const std::size_t                                     count;
+		const std::size_t                                     grain;
+		const std::size_t                                     participants;
+		std::unique_ptr<Queue[]>                              queues;
+		std::mutex                                            exceptionMutex;
+		std::exception_ptr                                    exception;
+	};
+
+	static bool& isInsideTask()
+	{
+		thread_local bool inside = false;
+		return inside;
+	}
+
+	void run(std::size_t index)
+	{
+		std::size_t seen = 0;
+		while (true)
+		{
+			std::unique_lock lock(mutex);
+			wakeUp.wait(lock, [this, seen] { return stopping || generation != seen; });
+			if (stopping)
+				return;
+			seen     = generation;
+			Job& job = *currentJob;
+			lock.unlock();
+
+			work(job, index);
+
+			lock.lock();
+			if (++finishedWorkers == threads.size())
+				done.notify_one();
+		}
+	}
+
+	void work(Job& job, std::size_t index)
+	{
+		isInsideTask() = true;
+		while (true)
+		{
+			std::optional<std::size_t> chunk = job.queues[index].pop();
+			for (std::size_t i = 1; !chunk && i < job.participants; i++)
+				chunk = job.queues[(index + i) % job.participants].steal();
+			if (!chunk)
+				break;
+
+			const std::size_t begin = *chunk * job.grain;
+			try
+			{
+				job.fn(begin, std::min(begin + job.grain, job.count));
+			}
+			catch (...)
+			{
+				std::scoped_lock lock(job.exceptionMutex);
+				if (!job.exception)
+					job.exception = std::current_exception();
+			}
+		}
+		isInsideTask() = false;
+	}
+
+	std::vector<std::thread> threads;
+	std::mutex               jobMutex;
+	std::mutex               mutex;
+	std::condition_variable  wakeUp;
+	std::condition_variable  done;
+	Job*                     currentJob      = nullptr;
+	std::size_t              generation      = 0;
+	std::size_t              finishedWorkers = 0;
+	bool                     stopping        = false;
+};
+
+/* getDefaultThreadPool
+Pool used by parallel policies that don't name one. Created on first use. */
+
+inline ThreadPool& getDefaultThreadPool()
+{
+	static ThreadPool pool;
+	return pool;
+}
+
+namespace execution
+{
+/* Execution policies
+Mirror std::execution's seq, par and par_unseq for geompp's span algorithms.
+Parallel policies run on the default pool, or on the one given to on(). The
+chunk size defaults to a value based on the input size and pool concurrency
+and can be forced with withGrain(). par_unseq currently behaves like par. */
+
+struct SequencedPolicy
+{
+};
+
+template <typename Derived>
+struct BasicParallelPolicy
+{
+	constexpr Derived on(ThreadPool& p) const { return {&p, grain}; }
+	constexpr Derived withGrain(std::size_t g) const { return {pool, g}; }
+
+	ThreadPool& getPool() const { return pool != nullptr ? *pool : getDefaultThreadPool(); }
+
+	ThreadPool* pool  = nullptr;
+	std::size_t grain = 0;
+};
+
+struct ParallelPolicy : BasicParallelPolicy<ParallelPolicy>
+{
+};
+
+struct ParallelUnsequencedPolicy : BasicParallelPolicy<ParallelUnsequencedPolicy>
+{
+};
+
+inline constexpr SequencedPolicy           seq;
+inline constexpr ParallelPolicy            par;
+inline constexpr ParallelUnsequencedPolicy par_unseq;
+
+template <typename P>
+constexpr bool isParallel = std::is_base_of_v<BasicParallelPolicy<P>, P>;
+} // namespace execution
+
+namespace detail
+{
+/* getGrain
+Chunk size used by forEachChunk() for the given policy and input size. The
+sequenced policy runs everything as a single chunk. */
+
+template <typename Policy>
+std::size_t getGrain(const Policy& policy, std::size_t count)
+{
+	if constexpr (execution::isParallel<Policy>)
+	{
+		if (policy.grain != 0)
+			return policy.grain;
+		return std::max<std::size_t>(1024, count / (policy.getPool().getConcurrency() * 8));
+	}
+	else
+		return std::max<std::size_t>(count, 1);
+}
+
+/* forEachChunk
+Calls fn(begin, end) over [0, count) according to the execution policy, in
+chunks of getGrain() elements. */
+
+template <typename Policy, typename F>
+void forEachChunk(const Policy& policy, std::size_t count, F&& fn)
+{
+	if constexpr (execution::isParallel<Policy>)
+		policy.getPool().parallelFor(count, getGrain(policy, count), fn);
+	else
+		fn(std::size_t{0}, count);
+}
+} // namespace detail
+} // namespace geompp
+
+#endif
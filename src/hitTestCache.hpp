@@ -0,0 +1,174 @@
+/* -----------------------------------------------------------------------------
+ *
+ * geompp - Basic geometrical utilities for C++.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2021 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of geompp - Basic geometrical utilities for C++.
+ *
+ * geompp - Basic geometrical utilities for C++ is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * geompp - Basic geometrical utilities for C++ is distributed in the hope that
+ * it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with geompp - Basic geometrical utilities for C++. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef GEOMPP_HITTESTCACHE_HH
+#define GEOMPP_HITTESTCACHE_HH
+
+#include "point.hpp"
+#include "rect.hpp"
+#include "stats.hpp"
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace geompp
+{
+/* HitTestCache
+Finds the topmost Rect containing a Point, for streams of queries where
+consecutive Points are close to each other (e.g. pointer events). Rects are
+stacked in insertion order, the last one on top. Along with the last answer the
+cache keeps a "safe" Rect around the last Point, where the answer can't change:
+queries inside it are answered in O(1), the others rescan all Rects and build a
+new safe Rect. Editing a Rect invalidates the cache only if the old or new Rect
+touches the safe one. */
+
+template <typename T>
+class HitTestCache
+{
+public:
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	/* HitTestCache (1)
+	Empty cache. */
+
+	HitTestCache() = default;
+
+	/* HitTestCache (2)
+	Cache over 'rects', from bottom to top. */
+
+	explicit HitTestCache(std::vector<Rect<T>> rects)
+	: rects(std::move(rects))
+	{
+	}
+
+	std::size_t size() const { return rects.size(); }
+
+	const Rect<T>& operator[](std::size_t i) const { return rects[i]; }
+
+	/* getSafeRect
+	Returns the area where the last answer holds. Invalid if there's no valid
+	cached answer. */
+
+	Rect<T> getSafeRect() const { return safe; }
+
+	/* hitTest
+	Returns the index of the topmost Rect containing Point p, or npos if there
+	is none. */
+
+	std::size_t hitTest(Point<T> p)
+	{
+		if (safe.isValid() && safe.contains(p))
+			return hit;
+
+		GEOMPP_STATS_ADD(candidatesTested, rects.size());
+
+		hit = npos;
+		for (std::size_t i = rects.size(); i-- > 0;)
+			if (rects[i].contains(p))
+			{
+				hit = i;
+				break;
+			}
+
+		/* The safe Rect starts as the hit Rect (or most of the plane on a
+		miss, leaving room for the arithmetic not to overflow) and gets carved
+		by every Rect above it that overlaps it, keeping the piece where p
+		lies. */
+
+		constexpr T LO = std::numeric_limits<T>::lowest() / 4;
+		constexpr T HI = std::numeric_limits<T>::max() / 2;
+
+		safe = hit == npos ? Rect<T>(LO, LO, HI, HI) : rects[hit];
+		for (std::size_t i = hit == npos ? 0 : hit + 1; i < rects.size(); i++)
+		{
+			if (!rects[i].intersects(safe))
+				continue;
+			for (const Rect<T>& piece : safe.getDifference(rects[i]))
+				if (piece.isValid() && piece.contains(p))
+				{
+					safe = piece;
+					break;
+				}
+		}
+		if (!safe.contains(p))
+			invalidate();
+
+		return hit;
+	}
+
+	/* add
+	Adds a Rect on top of the others. */
+
+	void add(const Rect<T>& r)
+	{
+		invalidateIfTouched(r);
+		rects.push_back(r);
+	}
+
+	/* set
+	Replaces the i-th Rect. */
+
+	void set(std::size_t i, const Rect<T>& r)
+	{
+		invalidateIfTouched(rects[i]);
+		invalidateIfTouched(r);
+		rects[i] = r;
+	}
+
+	/* remove
+	Removes the i-th Rect. Rects above it move one index down. */
+
+	void remove(std::size_t i)
+	{
+		invalidateIfTouched(rects[i]);
+		rects.erase(rects.begin() + i);
+		if (hit != npos && hit > i)
+			hit--;
+	}
+
+	void clear()
+	{
+		rects.clear();
+		invalidate();
+	}
+
+	void invalidate() { safe = {}; }
+
+private:
+	void invalidateIfTouched(const Rect<T>& r)
+	{
+		if (safe.isValid() && r.intersects(safe))
+			invalidate();
+	}
+
+	std::vector<Rect<T>> rects;
+	Rect<T>              safe;
+	std::size_t          hit = npos;
+};
+} // namespace geompp
+
+#endif
@@ -0,0 +1,280 @@
+/* -----------------------------------------------------------------------------
+ *
+ * geompp - Basic geometrical utilities for C++.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2021 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of geompp - Basic geometrical utilities for C++.
+ *
+ * geompp - Basic geometrical utilities for C++ is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * geompp - Basic geometrical utilities for C++ is distributed in the hope that
+ * it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with geompp - Basic geometrical utilities for C++. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef GEOMPP_PREDICATES_HH
+#define GEOMPP_PREDICATES_HH
+
+#include "line.hpp"
+#include "point.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+/* Robust geometric predicates
+The predicates below always return the exact answer for their input
+coordinates. They first evaluate the plain double expression and accept its
+sign when it is larger than the worst-case rounding error (Shewchuk's static
+filter). Near-degenerate inputs, and 64-bit integers too large for a double,
+fall back to exact arithmetic: 128-bit integers when the compiler has them and
+the values fit, expansions otherwise.
+Exactness relies on strict IEEE 754 double arithmetic: don't build them with
+-ffast-math or similar flags. Results for doubles close to overflow or
+underflow are not guaranteed. */
+
+namespace geompp
+{
+namespace detail
+{
+/* Expansion
+Sum of up to N doubles kept exactly as a sequence of non-overlapping
+components of increasing magnitude. See J. R. Shewchuk, "Adaptive Precision
+Floating-Point Arithmetic and Fast Robust Geometric Predicates", 1997. */
+
+template <std::size_t N>
+class Expansion
+{
+public:
+	/* add
+	Adds 'b' to the expansion exactly (Grow-Expansion with zero elimination). */
+
+	void add(double b)
+	{
+		if (b == 0)
+			return;
+
+		double      q = b;
+		std::size_t k = 0;
+		for (std::size_t i = 0; i < size; i++)
+		{
+			const double sum = q + components[i];
+			const double bv  = sum - q;
+			const double av  = sum - bv;
+			const double err = (q - av) + (components[i] - bv);
+			if (err != 0)
+				components[k++] = err;
+			q = sum;
+		}
+		if (q != 0)
+			components[k++] = q;
+		size = k;
+	}
+
+	/* addProduct
+	Adds a * b exactly, split into rounded product and rounding error. */
+
+	void addProduct(double a, double b)
+	{
+		const double p = a * b;
+		add(std::fma(a, b, -p));
+		add(p);
+	}
+
+	/* getSign
+	The sign of an expansion is the sign of its largest component. */
+
+	int getSign() const
+	{
+		return size == 0 ? 0 : components[size - 1] > 0 ? 1
+		                                                : -1;
+	}
+
+private:
+	std::array<double, N> components;
+	std::size_t           size = 0;
+};
+
+/* isFilterable
+True if every value of T converts exactly to double, which the static error
+bound assumes. */
+
+template <typename T>
+constexpr bool isFilterable = std::is_same_v<T, float> || std::is_same_v<T, double> ||
+                              (std::is_integral_v<T> && sizeof(T) <= 4);
+
+/* split
+Splits 'v' into two doubles whose exact sum is 'v'. Wide integers don't fit
+in a double mantissa, so they are cut in a high and a low 32-bit half. */
+
+template <typename T>
+std::array<double, 2> split(T v)
+{
+	static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, long double>,
+	    "Unsupported coordinate type");
+
+	if constexpr (std::is_integral_v<T> && sizeof(T) > 4)
+	{
+		const T lo = v & static_cast<T>(0xFFFFFFFF);
+		return {static_cast<double>(v - lo), static_cast<double>(lo)};
+	}
+	else
+		return {static_cast<double>(v), 0.0};
+}
+
+/* fitsBits
+True if the coordinates of Points a, b and c all lie in [-2^Bits, 2^Bits]. */
+
+template <int Bits, typename T>
+bool fitsBits(Point<T> a, Point<T> b, Point<T> c)
+{
+	constexpr T LIMIT = T{1} << Bits;
+
+	const auto fits = [](T v) {
+		if constexpr (std::is_signed_v<T>)
+			return v >= -LIMIT && v <= LIMIT;
+		else
+			return v <= LIMIT;
+	};
+	return fits(a.x) && fits(a.y) && fits(b.x) && fits(b.y) && fits(c.x) && fits(c.y);
+}
+
+/* orient2dFilter
+Evaluates the determinant in double precision and returns its sign, or 0 if it
+is within the worst-case rounding error and can't be trusted. Every
+coordinate must convert exactly to double. */
+
+template <typename T>
+int orient2dFilter(Point<T> a, Point<T> b, Point<T> c)
+{
+	constexpr double EPSILON     = std::numeric_limits<double>::epsilon() / 2;
+	constexpr double ERROR_BOUND = (3.0 + 16.0 * EPSILON) * EPSILON;
+
+	const double left  = (double(a.x) - double(c.x)) * (double(b.y) - double(c.y));
+	const double right = (double(a.y) - double(c.y)) * (double(b.x) - double(c.x));
+	const double det   = left - right;
+
+	if (std::abs(det) > ERROR_BOUND * (std::abs(left) + std::abs(right)))
+		return det > 0 ? 1 : -1;
+	return 0;
+}
+
+#ifdef __SIZEOF_INT128__
+/* orient2dInt128
+Exact determinant in 128-bit integers. Coordinates must fit in 61 bits, so
+that differences take 62, products 124 and their difference 125. */
+
+template <typename T>
+int orient2dInt128(Point<T> a, Point<T> b, Point<T> c)
+{
+	using Wide = __int128;
+
+	const Wide det = (Wide(a.x) - c.x) * (Wide(b.y) - c.y) - (Wide(a.y) - c.y) * (Wide(b.x) - c.x);
+	return (det > 0) - (det < 0);
+}
+#endif
+
+template <typename T>
+int orient2dExact(Point<T> a, Point<T> b, Point<T> c)
+{
+	Expansion<48> e;
+
+	/* Expanded determinant:
+	ax*by - ax*cy - cx*by - ay*bx + ay*cx + cy*bx */
+
+	const auto addProduct = [&e](T u, T v, bool negate) {
+		for (const double su : split(u))
+			for (const double sv : split(v))
+				if (su != 0 && sv != 0)
+					e.addProduct(negate ? -su : su, sv);
+	};
+
+	addProduct(a.x, b.y, false);
+	addProduct(a.x, c.y, true);
+	addProduct(c.x, b.y, true);
+	addProduct(a.y, b.x, true);
+	addProduct(a.y, c.x, false);
+	addProduct(c.y, b.x, false);
+
+	return e.getSign();
+}
+} // namespace detail
+
+/* orient2d
+Returns the orientation of Point c with respect to the directed line going
+from a to b: 1 if c lies to the left (a, b, c turn counterclockwise in y-up
+coordinates, clockwise on a y-down screen), -1 if it lies to the right, 0 if
+the three points are collinear. */
+
+template <typename T>
+int orient2d(Point<T> a, Point<T> b, Point<T> c)
+{
+	if constexpr (detail::isFilterable<T>)
+	{
+		if (const int sign = detail::orient2dFilter(a, b, c); sign != 0)
+			return sign;
+	}
+	else if constexpr (std::is_integral_v<T>)
+	{
+		/* Wide integers go through the same filter when they convert exactly
+		to double, which is the common case. */
+
+		if (detail::fitsBits<53>(a, b, c))
+			if (const int sign = detail::orient2dFilter(a, b, c); sign != 0)
+				return sign;
+#ifdef __SIZEOF_INT128__
+		if (detail::fitsBits<61>(a, b, c))
+			return detail::orient2dInt128(a, b, c);
+#endif
+	}
+	return detail::orient2dExact(a, b, c);
+}
+
+/* isOnSegment
+True if Point p lies on Line l, endpoints included. */
+
+template <typename T>
+bool isOnSegment(Point<T> p, const Line<T>& l)
+{
+	return orient2d<T>({l.x1, l.y1}, {l.x2, l.y2}, p) == 0 &&
+	       p.x >= std::min(l.x1, l.x2) && p.x <= std::max(l.x1, l.x2) &&
+	       p.y >= std::min(l.y1, l.y2) && p.y <= std::max(l.y1, l.y2);
+}
+
+/* intersects
+True if Lines l1 and l2, seen as closed segments, share at least one point. */
+
+template <typename T>
+bool intersects(const Line<T>& l1, const Line<T>& l2)
+{
+	const Point<T> a1{l1.x1, l1.y1}, a2{l1.x2, l1.y2};
+	const Point<T> b1{l2.x1, l2.y1}, b2{l2.x2, l2.y2};
+
+	const int d1 = orient2d(a1, a2, b1);
+	const int d2 = orient2d(a1, a2, b2);
+	const int d3 = orient2d(b1, b2, a1);
+	const int d4 = orient2d(b1, b2, a2);
+
+	if (d1 * d2 < 0 && d3 * d4 < 0)
+		return true;
+
+	return (d1 == 0 && isOnSegment(b1, l1)) || (d2 == 0 && isOnSegment(b2, l1)) ||
+	       (d3 == 0 && isOnSegment(a1, l2)) || (d4 == 0 && isOnSegment(a2, l2));
+}
+} // namespace geompp
+
+#endif
@@ -27,6 +27,7 @@
 #ifndef GEOMPP_RANGE_HH
 #define GEOMPP_RANGE_HH
 
+#include <algorithm>
 #include <cassert>
 #include <utility>
 
@@ -146,6 +147,19 @@ public:
 		return {r1, r2};
 	}
 
+	/* getUnion
+	Returns the smallest Range containing both this one and Range o. Invalid
+	Ranges are ignored. */
+
+	Range<T> getUnion(Range<T> o) const
+	{
+		if (!o.isValid())
+			return *this;
+		if (!isValid())
+			return o;
+		return {std::min(a, o.a), std::max(b, o.b)};
+	}
+
 	void setA(T newA)
 	{
 		assert(newA < b);
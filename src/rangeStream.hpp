@@ -0,0 +1,347 @@
+/* -----------------------------------------------------------------------------
+ *
+ * geompp - Basic geometrical utilities for C++.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2021 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of geompp - Basic geometrical utilities for C++.
+ *
+ * geompp - Basic geometrical utilities for C++ is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * geompp - Basic geometrical utilities for C++ is distributed in the hope that
+ * it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with geompp - Basic geometrical utilities for C++. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef GEOMPP_RANGESTREAM_HH
+#define GEOMPP_RANGESTREAM_HH
+
+#include "range.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+/* Range streams
+Pull-based sequences of Ranges. A stream is any object with a next() member
+function returning std::optional<Range<T>>, empty once the stream is over.
+The combinators below consume streams sorted by start lazily, one Range at a
+time: merging k streams takes O(k) memory, everything else O(1), regardless of
+the length of the streams. */
+
+namespace geompp
+{
+namespace detail
+{
+template <typename O>
+struct OptionalRangeScalar;
+
+template <typename T>
+struct OptionalRangeScalar<std::optional<Range<T>>>
+{
+	using type = T;
+};
+} // namespace detail
+
+/* RangeStreamScalar
+The T of the Ranges produced by stream S. */
+
+template <typename S>
+using RangeStreamScalar = typename detail::OptionalRangeScalar<decltype(std::declval<S&>().next())>::type;
+
+template <typename S>
+concept RangeStream = requires { typename RangeStreamScalar<S>; };
+
+/* SpanRangeStream
+Stream over an existing span of Ranges. The span must outlive the stream. */
+
+template <typename T>
+class SpanRangeStream
+{
+public:
+	SpanRangeStream(std::span<const Range<T>> ranges)
+	: ranges(ranges)
+	{
+	}
+
+	std::optional<Range<T>> next()
+	{
+		if (pos == ranges.size())
+			return {};
+		return ranges[pos++];
+	}
+
+private:
+	std::span<const Range<T>> ranges;
+	std::size_t               pos = 0;
+};
+
+/* MergeRangeStream
+Merges k streams sorted by start into a single stream sorted by start, using a
+heap of k elements. Ranges with the same start come out in source order. */
+
+template <RangeStream S>
+class MergeRangeStream
+{
+public:
+	using T = RangeStreamScalar<S>;
+
+	MergeRangeStream(std::vector<S> sources)
+	: sources(std::move(sources))
+	{
+		heap.reserve(this->sources.size());
+		for (std::size_t i = 0; i < this->sources.size(); i++)
+			pull(i);
+	}
+
+	std::optional<Range<T>> next()
+	{
+		if (heap.empty())
+			return {};
+
+		std::pop_heap(heap.begin(), heap.end(), isAfter);
+		const Entry top = heap.back();
+		heap.pop_back();
+		pull(top.source);
+		return top.range;
+	}
+
+private:
+	struct Entry
+	{
+		Range<T>    range;
+		std::size_t source;
+	};
+
+	static bool isAfter(const Entry& l, const Entry& r)
+	{
+		if (l.range.getA() != r.range.getA())
+			return l.range.getA() > r.range.getA();
+		return l.source > r.source;
+	}
+
+	void pull(std::size_t source)
+	{
+		if (std::optional<Range<T>> r = sources[source].next(); r)
+		{
+			heap.push_back({*r, source});
+			std::push_heap(heap.begin(), heap.end(), isAfter);
+		}
+	}
+
+	std::vector<S>     sources;
+	std::vector<Entry> heap;
+};
+
+/* CoalesceRangeStream
+Joins overlapping or touching Ranges of a stream sorted by start. Ranges
+separated by a hole not larger than 'gap' are joined too. The output is sorted
+and disjoint. */
+
+template <RangeStream S>
+class CoalesceRangeStream
+{
+public:
+	using T = RangeStreamScalar<S>;
+
+	CoalesceRangeStream(S source, T gap = T{0})
+	: source(std::move(source))
+	, gap(gap)
+	{
+	}
+
+	std::optional<Range<T>> next()
+	{
+		if (!pending)
+			pending = source.next();
+		if (!pending)
+			return {};
+
+		const T a = pending->getA();
+		T       b = pending->getB();
+		while ((pending = source.next()) && pending->getA() <= b + gap)
+			b = std::max(b, pending->getB());
+
+		return Range<T>(a, b);
+	}
+
+private:
+	S                       source;
+	T                       gap;
+	std::optional<Range<T>> pending;
+};
+
+namespace detail
+{
+/* MergeTwoRangeStream
+Two-way merge of streams of different types, sorted by start. */
+
+template <RangeStream A, RangeStream B>
+class MergeTwoRangeStream
+{
+public:
+	using T = RangeStreamScalar<A>;
+
+	MergeTwoRangeStream(A a, B b)
+	: a(std::move(a))
+	, b(std::move(b))
+	, ca(this->a.next())
+	, cb(this->b.next())
+	{
+	}
+
+	std::optional<Range<T>> next()
+	{
+		std::optional<Range<T>> out;
+		if (ca && (!cb || ca->getA() <= cb->getA()))
+		{
+			out = ca;
+			ca  = a.next();
+		}
+		else if (cb)
+		{
+			out = cb;
+			cb  = b.next();
+		}
+		return out;
+	}
+
+private:
+	A                       a;
+	B                       b;
+	std::optional<Range<T>> ca, cb;
+};
+} // namespace detail
+
+/* UnionRangeStream
+Union of two streams sorted by start, as a sorted and disjoint stream. Holes
+not larger than 'gap' are filled as in CoalesceRangeStream. */
+
+template <RangeStream A, RangeStream B>
+class UnionRangeStream
+{
+public:
+	using T = RangeStreamScalar<A>;
+
+	UnionRangeStream(A a, B b, T gap = T{0})
+	: merged({std::move(a), std::move(b)}, gap)
+	{
+	}
+
+	std::optional<Range<T>> next() { return merged.next(); }
+
+private:
+	CoalesceRangeStream<detail::MergeTwoRangeStream<A, B>> merged;
+};
+
+/* IntersectionRangeStream
+Intersection of two sorted and disjoint streams, e.g. the output of
+CoalesceRangeStream. */
+
+template <RangeStream A, RangeStream B>
+class IntersectionRangeStream
+{
+public:
+	using T = RangeStreamScalar<A>;
+
+	IntersectionRangeStream(A a, B b)
+	: a(std::move(a))
+	, b(std::move(b))
+	, ca(this->a.next())
+	, cb(this->b.next())
+	{
+	}
+
+	std::optional<Range<T>> next()
+	{
+		while (ca && cb)
+		{
+			const T lo = std::max(ca->getA(), cb->getA());
+			const T hi = std::min(ca->getB(), cb->getB());
+
+			if (ca->getB() < cb->getB())
+				ca = a.next();
+			else
+				cb = b.next();
+
+			if (lo < hi)
+				return Range<T>(lo, hi);
+		}
+		return {};
+	}
+
+private:
+	A                       a;
+	B                       b;
+	std::optional<Range<T>> ca, cb;
+};
+
+/* DifferenceRangeStream
+Ranges of stream 'a' not covered by stream 'b'. Both must be sorted and
+disjoint, e.g. the output of CoalesceRangeStream. */
+
+template <RangeStream A, RangeStream B>
+class DifferenceRangeStream
+{
+public:
+	using T = RangeStreamScalar<A>;
+
+	DifferenceRangeStream(A a, B b)
+	: a(std::move(a))
+	, b(std::move(b))
+	, ca(this->a.next())
+	, cb(this->b.next())
+	{
+	}
+
+	std::optional<Range<T>> next()
+	{
+		while (ca)
+		{
+			while (cb && cb->getB() <= ca->getA())
+				cb = b.next();
+
+			/* No more holes in the current Range: return it whole. */
+
+			if (!cb || cb->getA() >= ca->getB())
+				return std::exchange(ca, a.next());
+
+			/* Hole in the current Range: return the part before it, if any,
+			and keep the part after it. */
+
+			std::optional<Range<T>> out;
+			if (cb->getA() > ca->getA())
+				out = Range<T>(ca->getA(), cb->getA());
+
+			if (cb->getB() < ca->getB())
+				ca = Range<T>(cb->getB(), ca->getB());
+			else
+				ca = a.next();
+
+			if (out)
+				return out;
+		}
+		return {};
+	}
+
+private:
+	A                       a;
+	B                       b;
+	std::optional<Range<T>> ca, cb;
+};
+} // namespace geompp
+
+#endif
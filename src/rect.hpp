@@ -31,7 +31,13 @@
 #include "line.hpp"
 #include "point.hpp"
 #include "range.hpp"
+#include "stats.hpp"
 #include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <type_traits>
 
 namespace geompp
 {
@@ -64,10 +70,20 @@ public:
 	Rectangle generated by two ranges: horizontal and vertical. */
 
 	constexpr Rect(const Range<T>& h, const Range<T>& v)
-	: Rect(h.a, v.a, h.getLength(), v.getLength())
+	: Rect(h.getA(), v.getA(), h.getLength(), v.getLength())
 	{
 	}
 
+	bool operator==(const Rect<T>& o) const
+	{
+		return x == o.x && y == o.y && w == o.w && h == o.h;
+	}
+
+	bool operator!=(const Rect<T>& o) const
+	{
+		return !(*this == o);
+	}
+
 	Point<T> getTopLeft() const { return {x, y}; }
 	Point<T> getTopRight() const { return {xw, y}; }
 	Point<T> getBottomLeft() const { return {x, yh}; }
@@ -226,8 +242,8 @@ public:
 	/* with[Horizontal|Vertical]Range
 	Returns a copy of this rect new position and size defined by Range 'r'. */
 
-	Rect<T> withHorizontalRange(Range<T> r) const { return {r.a, y, r.getLength(), h}; }
-	Rect<T> withVerticalRange(Range<T> r) const { return {x, r.a, w, r.getLength()}; }
+	Rect<T> withHorizontalRange(Range<T> r) const { return {r.getA(), y, r.getLength(), h}; }
+	Rect<T> withVerticalRange(Range<T> r) const { return {x, r.getA(), w, r.getLength()}; }
 
 	/* withVerticalCenter
 	Returns a copy of this rect with new center defined by the y component of point 'p'. */
@@ -304,6 +320,14 @@ public:
 		return x <= o.x && y <= o.y && x + w >= o.x + o.w && y + h >= o.y + o.h;
 	}
 
+	/* intersects
+	True if Rect o intersects this one. */
+
+	bool intersects(const Rect<T>& o) const
+	{
+		return o.x < x + w && x < o.x + o.w && o.y < y + h && y < o.y + o.h;
+	}
+
 	/* getIntersection
 	Returns the intersection with another Rect o and this one. Might return
 	an invalid Rect if the two don't intersect. */
@@ -320,8 +344,81 @@ public:
 		return {nx, ny, nw, nh};
 	}
 
+	/* getUnion
+	Returns the smallest Rect containing both this one and Rect o, i.e. their
+	bounding box. Invalid Rects are ignored. */
+
+	Rect<T> getUnion(const Rect<T>& o) const
+	{
+		if (!o.isValid())
+			return *this;
+		if (!isValid())
+			return o;
+
+		T nx = std::min(x, o.x);
+		T ny = std::min(y, o.y);
+		T nw = std::max(x + w, o.x + o.w) - nx;
+		T nh = std::max(y + h, o.y + o.h) - ny;
+
+		return {nx, ny, nw, nh};
+	}
+
+	/* getDifference
+	Returns the area of this Rect not covered by Rect o, as up to four
+	non-overlapping pieces: top, bottom, left and right. Top and bottom span the
+	whole width of this Rect, left and right fill the band in between. Pieces
+	that would be empty are returned as invalid Rects. If the two don't
+	intersect, the first piece is this Rect itself. */
+
+	std::array<Rect<T>, 4> getDifference(const Rect<T>& o) const
+	{
+		if (!isValid())
+			return {};
+
+		const Rect<T> i = getIntersection(o);
+		if (!i.isValid())
+			return {*this, {}, {}, {}};
+
+		std::array<Rect<T>, 4> out;
+		if (i.y > y)
+			out[0] = {x, y, w, i.y - y};
+		if (yh > i.yh)
+			out[1] = {x, i.yh, w, yh - i.yh};
+		if (i.x > x)
+			out[2] = {x, i.y, i.x - x, i.h};
+		if (xw > i.xw)
+			out[3] = {i.xw, i.y, xw - i.xw, i.h};
+		return out;
+	}
+
 	T x, y, w, h, xw, yh;
 };
+
+/* subtract
+Subtracts Rect o from each Rect in 'rects' and writes the resulting valid
+pieces into the caller-provided buffer 'out', without allocating. Returns the
+number of Rects written. The buffer must be large enough to hold the worst
+case, i.e. four pieces per input Rect. */
+
+template <typename T>
+std::size_t subtract(std::type_identity_t<std::span<const Rect<T>>> rects, const Rect<T>& o, std::type_identity_t<std::span<Rect<T>>> out)
+{
+	GEOMPP_TRACE_SCOPE("geompp::subtract");
+	GEOMPP_STATS_ADD(candidatesTested, rects.size());
+
+	std::size_t count = 0;
+	for (const Rect<T>& r : rects)
+	{
+		for (const Rect<T>& piece : r.getDifference(o))
+		{
+			if (!piece.isValid())
+				continue;
+			assert(count < out.size());
+			out[count++] = piece;
+		}
+	}
+	return count;
+}
 } // namespace geompp
 
 #endif
\ No newline at end of file
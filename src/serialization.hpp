@@ -0,0 +1,462 @@
+/* -----------------------------------------------------------------------------
+ *
+ * geompp - Basic geometrical utilities for C++.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2021 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of geompp - Basic geometrical utilities for C++.
+ *
+ * geompp - Basic geometrical utilities for C++ is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * geompp - Basic geometrical utilities for C++ is distributed in the hope that
+ * it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with geompp - Basic geometrical utilities for C++. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef GEOMPP_SERIALIZATION_HH
+#define GEOMPP_SERIALIZATION_HH
+
+#include "line.hpp"
+#include "point.hpp"
+#include "range.hpp"
+#include "rect.hpp"
+#include "staticRangeMap.hpp"
+#include "stats.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+/* Binary format
+A blob is made of a fixed 32-byte header followed by a tightly packed array of
+elements. All values are stored little-endian regardless of the host.
+
+	offset  size  field
+	0       4     magic, "GMPP"
+	4       2     format version
+	6       1     element kind (see BinaryKind)
+	7       1     scalar type: 'i' signed, 'u' unsigned, 'f' floating point
+	8       1     scalar size in bytes
+	9       1     scalars per element
+	10      6     reserved, zero
+	16      8     element count
+	24      8     payload offset, from the beginning of the blob
+
+The payload offset makes the blob relocatable: a BinaryView can read it in
+place from any buffer, e.g. a memory-mapped file, without parsing it first.
+
+A RANGE_MAP blob holds a StaticRangeMap: its Ranges in tree order, then the
+original position of each one as a 64-bit unsigned integer. Its payload starts
+one node past a 64-byte boundary, so that in a buffer aligned to 64 bytes the
+tree keeps the cache line alignment it has in memory. */
+
+namespace geompp
+{
+enum class BinaryKind : std::uint8_t
+{
+	POINT = 1,
+	LINE,
+	RANGE,
+	RECT,
+	RANGE_MAP
+};
+
+namespace detail
+{
+constexpr std::array<char, 4> BINARY_MAGIC       = {'G', 'M', 'P', 'P'};
+constexpr std::uint16_t       BINARY_VERSION     = 1;
+constexpr std::size_t         BINARY_HEADER_SIZE = 32;
+
+template <typename T>
+T byteswapIfBigEndian(T v)
+{
+	static_assert(std::is_arithmetic_v<T>);
+	if constexpr (std::endian::native == std::endian::big)
+	{
+		auto bytes = std::bit_cast<std::array<std::byte, sizeof(T)>>(v);
+		std::reverse(bytes.begin(), bytes.end());
+		return std::bit_cast<T>(bytes);
+	}
+	return v;
+}
+
+template <typename T>
+void store(std::byte* dst, T v)
+{
+	v = byteswapIfBigEndian(v);
+	std::memcpy(dst, &v, sizeof(T));
+}
+
+template <typename T>
+T load(const std::byte* src)
+{
+	T v;
+	std::memcpy(&v, src, sizeof(T));
+	return byteswapIfBigEndian(v);
+}
+
+template <typename T>
+constexpr char getScalarType()
+{
+	static_assert(std::is_arithmetic_v<T>, "Only arithmetic scalars can be serialized");
+	return std::is_floating_point_v<T> ? 'f' : std::is_signed_v<T> ? 'i'
+	                                                                : 'u';
+}
+
+/* writeBinaryHeader
+Writes the header of a blob of 'count' elements of 'components' scalars of
+type Scalar, whose payload starts 'offset' bytes from 'p'. */
+
+template <typename Scalar>
+void writeBinaryHeader(std::byte* p, BinaryKind kind, std::size_t components, std::size_t count, std::size_t offset)
+{
+	std::memset(p, 0, BINARY_HEADER_SIZE);
+	std::memcpy(p, BINARY_MAGIC.data(), BINARY_MAGIC.size());
+	store<std::uint16_t>(p + 4, BINARY_VERSION);
+	store<std::uint8_t>(p + 6, static_cast<std::uint8_t>(kind));
+	store<std::uint8_t>(p + 7, getScalarType<Scalar>());
+	store<std::uint8_t>(p + 8, sizeof(Scalar));
+	store<std::uint8_t>(p + 9, static_cast<std::uint8_t>(components));
+	store<std::uint64_t>(p + 16, count);
+	store<std::uint64_t>(p + 24, offset);
+}
+
+/* readBinaryHeader
+Checks the header of the blob in 'bytes' against the expected layout, with
+'elementSize' payload bytes per element. Returns false if the blob is
+truncated or holds something else, otherwise sets 'payload' and 'count'. */
+
+template <typename Scalar>
+bool readBinaryHeader(std::span<const std::byte> bytes, BinaryKind kind, std::size_t components,
+    std::size_t elementSize, const std::byte*& payload, std::size_t& count)
+{
+	if (bytes.size() < BINARY_HEADER_SIZE)
+		return false;
+
+	const std::byte* p = bytes.data();
+	if (std::memcmp(p, BINARY_MAGIC.data(), BINARY_MAGIC.size()) != 0 ||
+	    load<std::uint16_t>(p + 4) != BINARY_VERSION ||
+	    load<std::uint8_t>(p + 6) != static_cast<std::uint8_t>(kind) ||
+	    load<std::uint8_t>(p + 7) != getScalarType<Scalar>() ||
+	    load<std::uint8_t>(p + 8) != sizeof(Scalar) ||
+	    load<std::uint8_t>(p + 9) != components)
+		return false;
+
+	const std::uint64_t n      = load<std::uint64_t>(p + 16);
+	const std::uint64_t offset = load<std::uint64_t>(p + 24);
+	if (offset < BINARY_HEADER_SIZE || offset > bytes.size() || n > (bytes.size() - offset) / elementSize)
+		return false;
+
+	payload = p + offset;
+	count   = static_cast<std::size_t>(n);
+	return true;
+}
+
+/* getRangeMapPayloadOffset
+Payload offset of RANGE_MAP blobs: one node past a cache line boundary, after
+the header. */
+
+template <typename T>
+constexpr std::size_t getRangeMapPayloadOffset()
+{
+	return CACHE_LINE + 2 * sizeof(T);
+}
+} // namespace detail
+
+/* BinaryTraits
+Describes how each geometry type maps to a sequence of scalars. */
+
+template <typename G>
+struct BinaryTraits;
+
+template <typename T>
+struct BinaryTraits<Point<T>>
+{
+	using Scalar = T;
+
+	static constexpr BinaryKind  kind       = BinaryKind::POINT;
+	static constexpr std::size_t components = 2;
+
+	static std::array<T, 2> encode(const Point<T>& p) { return {p.x, p.y}; }
+	static Point<T>         decode(const std::array<T, 2>& v) { return {v[0], v[1]}; }
+};
+
+template <typename T>
+struct BinaryTraits<Line<T>>
+{
+	using Scalar = T;
+
+	static constexpr BinaryKind  kind       = BinaryKind::LINE;
+	static constexpr std::size_t components = 4;
+
+	static std::array<T, 4> encode(const Line<T>& l) { return {l.x1, l.y1, l.x2, l.y2}; }
+	static Line<T>          decode(const std::array<T, 4>& v) { return {v[0], v[1], v[2], v[3]}; }
+};
+
+template <typename T>
+struct BinaryTraits<Range<T>>
+{
+	using Scalar = T;
+
+	static constexpr BinaryKind  kind       = BinaryKind::RANGE;
+	static constexpr std::size_t components = 2;
+
+	static std::array<T, 2> encode(const Range<T>& r) { return {r.getA(), r.getB()}; }
+	static Range<T>         decode(const std::array<T, 2>& v) { return v[0] < v[1] ? Range<T>(v[0], v[1]) : Range<T>(); }
+};
+
+template <typename T>
+struct BinaryTraits<Rect<T>>
+{
+	using Scalar = T;
+
+	static constexpr BinaryKind  kind       = BinaryKind::RECT;
+	static constexpr std::size_t components = 4;
+
+	static std::array<T, 4> encode(const Rect<T>& r) { return {r.x, r.y, r.w, r.h}; }
+	static Rect<T>          decode(const std::array<T, 4>& v) { return {v[0], v[1], v[2], v[3]}; }
+};
+
+/* getBinarySize
+Returns the size in bytes of a blob holding 'count' elements of type G. */
+
+template <typename G>
+constexpr std::size_t getBinarySize(std::size_t count)
+{
+	using Traits = BinaryTraits<G>;
+	return detail::BINARY_HEADER_SIZE + count * Traits::components * sizeof(typename Traits::Scalar);
+}
+
+/* writeBinary (1)
+Serializes 'elements' into the caller-provided buffer 'out', which must be at
+least getBinarySize<G>(elements.size()) bytes long. Returns the number of bytes
+written. */
+
+template <typename G>
+std::size_t writeBinary(std::type_identity_t<std::span<const G>> elements, std::span<std::byte> out)
+{
+	using Traits = BinaryTraits<G>;
+	using Scalar = typename Traits::Scalar;
+
+	const std::size_t size = getBinarySize<G>(elements.size());
+	assert(out.size() >= size);
+
+	std::byte* p = out.data();
+	detail::writeBinaryHeader<Scalar>(p, Traits::kind, Traits::components, elements.size(), detail::BINARY_HEADER_SIZE);
+
+	p += detail::BINARY_HEADER_SIZE;
+	for (const G& e : elements)
+		for (const Scalar v : Traits::encode(e))
+		{
+			detail::store<Scalar>(p, v);
+			p += sizeof(Scalar);
+		}
+
+	return size;
+}
+
+/* writeBinary (2)
+Same as above, but appends the blob to a byte vector. */
+
+template <typename G>
+void writeBinary(std::type_identity_t<std::span<const G>> elements, std::vector<std::byte>& out)
+{
+	const std::size_t offset = out.size();
+	const std::size_t size   = offset + getBinarySize<G>(elements.size());
+	if (size > out.capacity())
+		GEOMPP_STATS_ADD(allocations, 1);
+	out.resize(size);
+	writeBinary<G>(elements, std::span(out).subspan(offset));
+}
+
+/* BinaryView
+Read-only, zero-copy view over a blob produced by writeBinary. Elements are
+decoded on access straight from the underlying bytes, so opening a view costs
+only the header check. The bytes must outlive the view. A view over a blob
+that is truncated, of another version or holding another element type is
+invalid and empty. */
+
+template <typename G>
+class BinaryView
+{
+public:
+	using Traits = BinaryTraits<G>;
+	using Scalar = typename Traits::Scalar;
+
+	/* BinaryView (1)
+	Invalid, empty view. */
+
+	BinaryView() = default;
+
+	/* BinaryView (2)
+	View over the blob in 'bytes'. */
+
+	BinaryView(std::span<const std::byte> bytes)
+	: valid(detail::readBinaryHeader<Scalar>(bytes, Traits::kind, Traits::components, ELEMENT_SIZE, payload, count))
+	{
+	}
+
+	bool        isValid() const { return valid; }
+	std::size_t size() const { return count; }
+
+	/* operator []
+	Decodes and returns the i-th element. */
+
+	G operator[](std::size_t i) const
+	{
+		assert(i < count);
+
+		const std::byte*                       p = payload + i * ELEMENT_SIZE;
+		std::array<Scalar, Traits::components> v;
+		for (std::size_t c = 0; c < Traits::components; c++)
+			v[c] = detail::load<Scalar>(p + c * sizeof(Scalar));
+		return Traits::decode(v);
+	}
+
+private:
+	static constexpr std::size_t ELEMENT_SIZE = Traits::components * sizeof(Scalar);
+
+	const std::byte* payload = nullptr;
+	std::size_t      count   = 0;
+	bool             valid   = false;
+};
+
+/* getBinarySize (2)
+Returns the size in bytes of the blob holding 'map'. */
+
+template <typename T>
+std::size_t getBinarySize(const StaticRangeMap<T>& map)
+{
+	return detail::getRangeMapPayloadOffset<T>() + map.size() * (2 * sizeof(T) + sizeof(std::uint64_t));
+}
+
+/* writeBinary (3)
+Serializes 'map' into the caller-provided buffer 'out', which must be at least
+getBinarySize(map) bytes long. Returns the number of bytes written. */
+
+template <typename T>
+std::size_t writeBinary(const StaticRangeMap<T>& map, std::span<std::byte> out)
+{
+	const std::size_t size   = getBinarySize(map);
+	const std::size_t offset = detail::getRangeMapPayloadOffset<T>();
+	assert(out.size() >= size);
+
+	std::byte* p = out.data();
+	std::memset(p, 0, offset);
+	detail::writeBinaryHeader<T>(p, BinaryKind::RANGE_MAP, 2, map.size(), offset);
+
+	p += offset;
+	for (const Range<T>& r : map.getNodes())
+	{
+		detail::store<T>(p, r.getA());
+		detail::store<T>(p + sizeof(T), r.getB());
+		p += 2 * sizeof(T);
+	}
+	for (const std::size_t i : map.getIndexes())
+	{
+		detail::store<std::uint64_t>(p, i);
+		p += sizeof(std::uint64_t);
+	}
+
+	return size;
+}
+
+/* writeBinary (4)
+Same as above, but appends the blob to a byte vector. */
+
+template <typename T>
+void writeBinary(const StaticRangeMap<T>& map, std::vector<std::byte>& out)
+{
+	const std::size_t offset = out.size();
+	const std::size_t size   = offset + getBinarySize(map);
+	if (size > out.capacity())
+		GEOMPP_STATS_ADD(allocations, 1);
+	out.resize(size);
+	writeBinary(map, std::span(out).subspan(offset));
+}
+
+/* StaticRangeMapView
+Read-only, zero-copy view over a StaticRangeMap blob produced by writeBinary.
+Lookups walk the tree straight from the underlying bytes, like
+StaticRangeMap's own, so the map answers queries as soon as the header is
+checked. Same validity rules and lifetime as BinaryView. */
+
+template <typename T>
+class StaticRangeMapView
+{
+public:
+	static constexpr std::size_t npos = StaticRangeMap<T>::npos;
+
+	/* StaticRangeMapView (1)
+	Invalid, empty view. */
+
+	StaticRangeMapView() = default;
+
+	/* StaticRangeMapView (2)
+	View over the blob in 'bytes'. */
+
+	StaticRangeMapView(std::span<const std::byte> bytes)
+	: valid(detail::readBinaryHeader<T>(bytes, BinaryKind::RANGE_MAP, 2, NODE_SIZE + sizeof(std::uint64_t), nodes, count))
+	{
+	}
+
+	bool        isValid() const { return valid; }
+	std::size_t size() const { return count; }
+
+	/* findIndex
+	Same as StaticRangeMap::findIndex. */
+
+	std::size_t findIndex(T t) const
+	{
+		const std::size_t k = findNode(t);
+		return k == 0 ? npos : static_cast<std::size_t>(detail::load<std::uint64_t>(nodes + count * NODE_SIZE + (k - 1) * sizeof(std::uint64_t)));
+	}
+
+	/* find
+	Returns the Range that contains 't', or an invalid Range if there is
+	none. */
+
+	Range<T> find(T t) const
+	{
+		const std::size_t k = findNode(t);
+		return k == 0 ? Range<T>() : Range<T>(getA(k), getB(k));
+	}
+
+private:
+	static constexpr std::size_t NODE_SIZE = 2 * sizeof(T);
+
+	T getA(std::size_t k) const { return detail::load<T>(nodes + (k - 1) * NODE_SIZE); }
+	T getB(std::size_t k) const { return detail::load<T>(nodes + (k - 1) * NODE_SIZE + sizeof(T)); }
+
+	std::size_t findNode(T t) const
+	{
+		return detail::findEytzinger<NODE_SIZE>(
+		    reinterpret_cast<std::uintptr_t>(nodes) - NODE_SIZE, count, t,
+		    [this](std::size_t k) { return getA(k); },
+		    [this](std::size_t k) { return getB(k); });
+	}
+
+	const std::byte* nodes = nullptr;
+	std::size_t      count = 0;
+	bool             valid = false;
+};
+} // namespace geompp
+
+#endif
@@ -0,0 +1,296 @@
+/* -----------------------------------------------------------------------------
+ *
+ * geompp - Basic geometrical utilities for C++.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2021 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of geompp - Basic geometrical utilities for C++.
+ *
+ * geompp - Basic geometrical utilities for C++ is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * geompp - Basic geometrical utilities for C++ is distributed in the hope that
+ * it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with geompp - Basic geometrical utilities for C++. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef GEOMPP_STATICRANGEMAP_HH
+#define GEOMPP_STATICRANGEMAP_HH
+
+#include "execution.hpp"
+#include "range.hpp"
+#include "stats.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace geompp
+{
+namespace detail
+{
+constexpr std::size_t CACHE_LINE = 64;
+
+/* prefetch
+Takes an address rather than a pointer: the nodes prefetched near the bottom
+of a tree are past the end of the array, and pointing there would be undefined
+behavior. Prefetching never faults. */
+
+inline void prefetch([[maybe_unused]] std::uintptr_t address)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	__builtin_prefetch(reinterpret_cast<const void*>(address));
+#endif
+}
+
+/* findEytzinger
+Walks an Eytzinger tree of 'count' nodes of NodeSize bytes, node k being at
+'address' + k * NodeSize, and returns the index of the node that contains 't',
+or 0. getA(k) and getB(k) return the ends of node k. Shared by StaticRangeMap
+and by its serialized view, which reads the nodes straight from a blob. */
+
+template <std::size_t NodeSize, typename T, typename GetA, typename GetB>
+std::size_t findEytzinger(std::uintptr_t address, std::size_t count, T t, GetA getA, GetB getB)
+{
+	constexpr std::size_t NODES_PER_LINE = std::max<std::size_t>(CACHE_LINE / NodeSize, 1);
+
+	std::size_t k = 1;
+	while (k <= count)
+	{
+		prefetch(address + k * NODES_PER_LINE * NodeSize);
+		k = 2 * k + (getA(k) <= t);
+		GEOMPP_STATS_ADD(nodesVisited, 1);
+	}
+
+	/* The bits of k below the leading one record the path taken, 1 for each
+	right turn. Dropping the trailing left turns and the last right one yields
+	the last node whose start is <= t. */
+
+	k >>= std::countr_zero(k) + 1;
+	return k != 0 && t < getB(k) ? k : 0;
+}
+} // namespace detail
+
+/* StaticRangeMap
+Read-only lookup table that finds which of a fixed set of Ranges contains a
+value. Ranges are stored in Eytzinger (breadth-first) order, so a lookup walks
+down an implicit binary tree whose top levels share a few cache lines, with a
+branchless loop that prefetches the nodes a cache line's worth of levels
+below. The containing Range is the last node visited while going right, so
+checking its end never misses the cache. Build it once, query it many times. */
+
+template <typename T>
+class StaticRangeMap
+{
+public:
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	/* StaticRangeMap (1)
+	Empty map. */
+
+	StaticRangeMap() = default;
+
+	/* StaticRangeMap (2)
+	Map over 'ranges', which must be valid, sorted and non-overlapping. */
+
+	explicit StaticRangeMap(std::span<const Range<T>> ranges)
+	: StaticRangeMap(execution::seq, ranges)
+	{
+	}
+
+	/* StaticRangeMap (3)
+	Same as above, built according to an execution policy. The parallel
+	version builds the subtrees a few levels below the root in their own
+	tasks, each one starting from the sorted position of its leftmost Range,
+	then fills the levels above them. */
+
+	template <typename Policy>
+	StaticRangeMap(const Policy& policy, std::span<const Range<T>> ranges)
+	: tree(ranges.size() + 1 + NODES_PER_LINE)
+	, indexes(ranges.size() + 1)
+	, count(ranges.size())
+	{
+		for (std::size_t i = 1; i < ranges.size(); i++)
+			assert(ranges[i - 1].getB() <= ranges[i].getA());
+
+		offset = getAlignedOffset();
+
+		if constexpr (!execution::isParallel<Policy>)
+		{
+			std::size_t next = 0;
+			build(ranges, 1, next);
+		}
+		else
+		{
+			const std::size_t roots = std::bit_ceil(policy.getPool().getConcurrency() * 4);
+
+			detail::forEachChunk(policy.withGrain(1), roots, [&](std::size_t begin, std::size_t end) {
+				for (std::size_t k = roots + begin; k < roots + end; k++)
+				{
+					std::size_t next = getFirstRank(k);
+					build(ranges, k, next);
+				}
+			});
+
+			for (std::size_t k = 1; k < roots && k <= count; k++)
+			{
+				const std::size_t rank = getFirstRank(k) + getSubtreeSize(2 * k);
+				tree[offset + k]       = ranges[rank];
+				indexes[k]             = rank;
+			}
+		}
+	}
+
+	/* StaticRangeMap (4)
+	Copy. The tree is aligned again in the new buffer, whose address generally
+	differs from the original's. */
+
+	StaticRangeMap(const StaticRangeMap& o)
+	: tree(o.tree.size())
+	, indexes(o.indexes)
+	, count(o.count)
+	, offset(getAlignedOffset())
+	{
+		if (!tree.empty())
+			std::copy_n(o.getTree(), count + 1, tree.data() + offset);
+	}
+
+	/* StaticRangeMap (5)
+	Move. The tree keeps its buffer, and so its alignment. 'o' is left empty. */
+
+	StaticRangeMap(StaticRangeMap&& o) noexcept
+	: tree(std::move(o.tree))
+	, indexes(std::move(o.indexes))
+	, count(std::exchange(o.count, 0))
+	, offset(std::exchange(o.offset, 0))
+	{
+	}
+
+	StaticRangeMap& operator=(const StaticRangeMap& o) { return *this = StaticRangeMap(o); }
+
+	StaticRangeMap& operator=(StaticRangeMap&& o) noexcept
+	{
+		tree    = std::move(o.tree);
+		indexes = std::move(o.indexes);
+		count   = std::exchange(o.count, 0);
+		offset  = std::exchange(o.offset, 0);
+		return *this;
+	}
+
+	std::size_t size() const { return count; }
+
+	/* getNodes, getIndexes
+	The Ranges in tree order, node k at position k - 1, and the position in the
+	original span of each one. For serialization. */
+
+	std::span<const Range<T>>    getNodes() const { return count == 0 ? std::span<const Range<T>>() : std::span(getTree() + 1, count); }
+	std::span<const std::size_t> getIndexes() const { return count == 0 ? std::span<const std::size_t>() : std::span(indexes.data() + 1, count); }
+
+	/* findIndex
+	Returns the position in the original span of the Range that contains 't',
+	as in Range::contains, or npos if there is none. */
+
+	std::size_t findIndex(T t) const
+	{
+		const std::size_t k = findNode(t);
+		return k == 0 ? npos : indexes[k];
+	}
+
+	/* find
+	Returns the Range that contains 't', or nullptr if there is none. */
+
+	const Range<T>* find(T t) const
+	{
+		const std::size_t k = findNode(t);
+		return k == 0 ? nullptr : getTree() + k;
+	}
+
+private:
+	static constexpr std::size_t NODES_PER_LINE = std::max<std::size_t>(detail::CACHE_LINE / sizeof(Range<T>), 1);
+
+	/* getAlignedOffset
+	Returns the position in 'tree' where the root must go so that the
+	descendants of a node that fit in a cache line start on a cache line
+	boundary. */
+
+	std::size_t getAlignedOffset() const
+	{
+		const auto address = reinterpret_cast<std::uintptr_t>(tree.data());
+		return (detail::CACHE_LINE - address % detail::CACHE_LINE) % detail::CACHE_LINE / sizeof(Range<T>);
+	}
+
+	const Range<T>* getTree() const { return tree.data() + offset; }
+
+	/* findNode
+	Returns the tree index of the Range that contains 't', or 0. */
+
+	std::size_t findNode(T t) const
+	{
+		const Range<T>* nodes = getTree();
+		return detail::findEytzinger<sizeof(Range<T>)>(
+		    reinterpret_cast<std::uintptr_t>(nodes), count, t,
+		    [nodes](std::size_t k) { return nodes[k].getA(); },
+		    [nodes](std::size_t k) { return nodes[k].getB(); });
+	}
+
+	/* getSubtreeSize
+	Number of nodes in the subtree rooted at node k. */
+
+	std::size_t getSubtreeSize(std::size_t k) const
+	{
+		std::size_t size = 0;
+		for (std::size_t first = k, last = k; first <= count; first = 2 * first, last = 2 * last + 1)
+			size += std::min(last, count) - first + 1;
+		return size;
+	}
+
+	/* getFirstRank
+	Sorted position of the leftmost Range in the subtree rooted at node k: the
+	path from the root to k skips a left subtree and its parent at each right
+	turn. */
+
+	std::size_t getFirstRank(std::size_t k) const
+	{
+		std::size_t rank = 0;
+		for (int bit = static_cast<int>(std::bit_width(k)) - 2; bit >= 0; bit--)
+			if ((k >> bit) & 1)
+				rank += getSubtreeSize((k >> (bit + 1)) * 2) + 1;
+		return rank;
+	}
+
+	/* build
+	Fills the tree with an in-order visit, so that in-order position matches
+	the sorted position of each Range. */
+
+	void build(std::span<const Range<T>> ranges, std::size_t k, std::size_t& next)
+	{
+		if (k > count)
+			return;
+		build(ranges, 2 * k, next);
+		tree[offset + k] = ranges[next];
+		indexes[k]       = next++;
+		build(ranges, 2 * k + 1, next);
+	}
+
+	std::vector<Range<T>>    tree;
+	std::vector<std::size_t> indexes;
+	std::size_t              count  = 0;
+	std::size_t              offset = 0;
+};
+} // namespace geompp
+
+#endif
@@ -0,0 +1,84 @@
+/* -----------------------------------------------------------------------------
+ *
+ * geompp - Basic geometrical utilities for C++.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2021 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of geompp - Basic geometrical utilities for C++.
+ *
+ * geompp - Basic geometrical utilities for C++ is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * geompp - Basic geometrical utilities for C++ is distributed in the hope that
+ * it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with geompp - Basic geometrical utilities for C++. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef GEOMPP_STATS_HH
+#define GEOMPP_STATS_HH
+
+#include <cstdint>
+
+/* GEOMPP_STATS
+Define to 1 to enable counters and trace hooks in geompp's hot paths. When
+disabled (the default) the instrumentation macros expand to nothing and this
+header pulls in nothing else. Tracing lives in trace.hpp. */
+
+#ifndef GEOMPP_STATS
+#define GEOMPP_STATS 0
+#endif
+
+namespace geompp
+{
+/* Stats
+Per-thread counters updated by indexes and batch kernels. simdPaths and
+scalarPaths count the chunks that kernels with a vectorized version ran
+through each path. */
+
+struct Stats
+{
+	std::uint64_t nodesVisited     = 0;
+	std::uint64_t candidatesTested = 0;
+	std::uint64_t allocations      = 0;
+	std::uint64_t simdPaths        = 0;
+	std::uint64_t scalarPaths      = 0;
+};
+
+/* getStats
+Returns the counters of the calling thread. Always zero when GEOMPP_STATS is
+disabled. */
+
+inline Stats& getStats()
+{
+	thread_local Stats stats;
+	return stats;
+}
+
+inline void resetStats() { getStats() = {}; }
+} // namespace geompp
+
+/* GEOMPP_STATS_ADD, GEOMPP_TRACE_SCOPE
+Instrumentation macros used by geompp's hot paths. */
+
+#if GEOMPP_STATS
+#include "trace.hpp"
+#define GEOMPP_STATS_CONCAT_(a, b) a##b
+#define GEOMPP_STATS_CONCAT(a, b) GEOMPP_STATS_CONCAT_(a, b)
+#define GEOMPP_STATS_ADD(field, n) (::geompp::getStats().field += (n))
+#define GEOMPP_TRACE_SCOPE(name) ::geompp::detail::ScopedTrace GEOMPP_STATS_CONCAT(geomppTrace, __LINE__)(name)
+#else
+#define GEOMPP_STATS_ADD(field, n) ((void)0)
+#define GEOMPP_TRACE_SCOPE(name) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,135 @@
+/* -----------------------------------------------------------------------------
+ *
+ * geompp - Basic geometrical utilities for C++.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2021 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of geompp - Basic geometrical utilities for C++.
+ *
+ * geompp - Basic geometrical utilities for C++ is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * geompp - Basic geometrical utilities for C++ is distributed in the hope that
+ * it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with geompp - Basic geometrical utilities for C++. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef GEOMPP_TRACE_HH
+#define GEOMPP_TRACE_HH
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <unordered_map>
+
+namespace geompp
+{
+/* TraceCallback
+Called at the end of each traced scope with its name, start time and
+duration, both in microseconds from an arbitrary steady epoch. Scopes are
+traced only when GEOMPP_STATS is enabled. */
+
+using TraceCallback = std::function<void(const char* name, std::int64_t start, std::int64_t duration)>;
+
+namespace detail
+{
+inline TraceCallback& getTraceCallback()
+{
+	static TraceCallback callback;
+	return callback;
+}
+
+inline std::int64_t getTraceTime()
+{
+	using namespace std::chrono;
+	return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+class ScopedTrace
+{
+public:
+	ScopedTrace(const char* name)
+	: name(name)
+	, start(getTraceTime())
+	{
+	}
+
+	~ScopedTrace()
+	{
+		if (const TraceCallback& callback = getTraceCallback(); callback)
+			callback(name, start, getTraceTime() - start);
+	}
+
+private:
+	const char*  name;
+	std::int64_t start;
+};
+} // namespace detail
+
+/* setTraceCallback
+Installs the function that receives traced scopes. Pass an empty function to
+disable tracing. Not thread-safe: call it before running any instrumented
+code. */
+
+inline void setTraceCallback(TraceCallback callback)
+{
+	detail::getTraceCallback() = std::move(callback);
+}
+
+/* ChromeTraceWriter
+Writes traced scopes to a stream in the Chrome trace event format, viewable in
+chrome://tracing or Perfetto. Usage:
+
+	ChromeTraceWriter writer(file);
+	setTraceCallback(std::ref(writer));
+
+Threads are numbered from 0 in order of appearance. The JSON array is closed
+when the writer is destroyed. */
+
+class ChromeTraceWriter
+{
+public:
+	ChromeTraceWriter(std::ostream& out)
+	: out(out)
+	{
+		out << "[";
+	}
+
+	~ChromeTraceWriter()
+	{
+		out << "\n]\n";
+	}
+
+	void operator()(const char* name, std::int64_t start, std::int64_t duration)
+	{
+		std::scoped_lock  lock(mutex);
+		const std::size_t tid = threads.try_emplace(std::this_thread::get_id(), threads.size()).first->second;
+
+		out << (first ? "\n" : ",\n")
+		    << R"({"name":")" << name << R"(","ph":"X","pid":0,"tid":)" << tid
+		    << R"(,"ts":)" << start << R"(,"dur":)" << duration << "}";
+		first = false;
+	}
+
+private:
+	std::ostream&                                    out;
+	std::mutex                                       mutex;
+	std::unordered_map<std::thread::id, std::size_t> threads;
+	bool                                             first = true;
+};
+} // namespace geompp
+
+#endif
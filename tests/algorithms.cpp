@@ -0,0 +1,182 @@
+#include "src/algorithms.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("Algorithms")
+{
+	using namespace geompp;
+
+	ThreadPool pool(3);
+
+	std::vector<Rect<int>> rects;
+	for (int i = 0; i < 5000; i++)
+		rects.push_back({(i * 37) % 1000, (i * 91) % 1000, 1 + i % 50, 1 + i % 30});
+
+	const auto par = execution::par.on(pool).withGrain(64);
+
+	SECTION("Test thread pool")
+	{
+		std::vector<std::atomic<int>> hits(10000);
+		std::atomic<bool>             aligned = true;
+		pool.parallelFor(hits.size(), 7, [&](std::size_t begin, std::size_t end) {
+			if (begin % 7 != 0)
+				aligned = false;
+			for (std::size_t i = begin; i < end; i++)
+				hits[i]++;
+		});
+		REQUIRE(aligned);
+		for (const std::atomic<int>& h : hits)
+			REQUIRE(h == 1);
+	}
+
+	SECTION("Test nested and failing tasks")
+	{
+		std::atomic<int> sum = 0;
+		pool.parallelFor(100, 10, [&](std::size_t begin, std::size_t end) {
+			pool.parallelFor(end - begin, 1, [&](std::size_t b, std::size_t e) { sum += static_cast<int>(e - b); });
+		});
+		REQUIRE(sum == 100);
+
+		REQUIRE_THROWS_AS(pool.parallelFor(100, 1, [](std::size_t begin, std::size_t) {
+			if (begin == 42)
+				throw std::runtime_error("");
+		}),
+		    std::runtime_error);
+	}
+
+	SECTION("Test transform")
+	{
+		std::vector<Rect<int>> seqOut(rects.size()), parOut(rects.size());
+		const auto             fn = [](const Rect<int>& r) { return r.withShiftedX(10); };
+
+		transform(execution::seq, rects, seqOut, fn);
+		transform(par, rects, parOut, fn);
+
+		REQUIRE(seqOut == parOut);
+		REQUIRE(seqOut[10] == rects[10].withShiftedX(10));
+	}
+
+	SECTION("Test cull")
+	{
+		const Rect<int>        viewport{200, 200, 300, 300};
+		std::vector<Rect<int>> seqOut(rects.size()), parOut(rects.size());
+
+		const std::size_t seqCount = cull(execution::seq, rects, viewport, seqOut);
+		const std::size_t parCount = cull(par, rects, viewport, parOut);
+
+		REQUIRE(seqCount > 0);
+		REQUIRE(seqCount < rects.size());
+		REQUIRE(seqCount == parCount);
+		REQUIRE(seqOut == parOut);
+	}
+
+	SECTION("Test subtract")
+	{
+		const Rect<int>        occluder{100, 100, 600, 600};
+		std::vector<Rect<int>> seqOut(rects.size() * 4), parOut(rects.size() * 4);
+
+		const std::size_t seqCount = subtract(execution::seq, rects, occluder, seqOut);
+		const std::size_t parCount = subtract(execution::par_unseq.on(pool).withGrain(100), rects, occluder, parOut);
+
+		REQUIRE(seqCount == parCount);
+		REQUIRE(seqOut == parOut);
+	}
+
+	SECTION("Test fixed-point scale")
+	{
+		using Fx = Fixed<24, 8>;
+
+		std::vector<Rect<Fx>> seqRects, parRects;
+		for (const Rect<int>& r : rects)
+			seqRects.push_back({r.x, r.y, r.w, r.h});
+		parRects = seqRects;
+
+		scale(execution::seq, seqRects, Fx(0.75));
+		scale(par, parRects, Fx(0.75));
+
+		REQUIRE(seqRects == parRects);
+	}
+
+	SECTION("Test hull")
+	{
+		Rect<int> expected;
+		for (const Rect<int>& r : rects)
+			expected = expected.getUnion(r);
+
+		REQUIRE(getHull(execution::seq, rects) == expected);
+		REQUIRE(getHull(par, rects) == expected);
+		REQUIRE(!getHull(execution::seq, std::vector<Rect<int>>{{}, {5, 5, 0, 3}}).isValid());
+
+		/* Invalid Rects anywhere, and odd counts, on top of the all-valid case
+		above. */
+
+		std::vector<Rect<int>> some = {{10, 10, 5, 5}, {}, {-3, 20, 2, 2}, {0, 0, -4, 9}, {30, -7, 1, 1}};
+		REQUIRE(getHull(execution::seq, some) == Rect{-3, -7, 34, 29});
+		some.pop_back();
+		REQUIRE(getHull(execution::seq, some) == Rect{-3, 10, 18, 12});
+		REQUIRE(getHull(execution::seq, std::vector<Rect<int>>{{}, {1, 2, 3, 4}}) == Rect{1, 2, 3, 4});
+		REQUIRE(getHull(execution::seq, std::vector<Rect<float>>{{0.5f, 1, 2, 2}, {-1, 0, 1, 1}}) ==
+		        Rect<float>{-1, 0, 3.5f, 3});
+		REQUIRE(getHull(execution::seq, std::vector<Rect<float>>{{0.5f, 1, 2, 2}, {-9, 0, 0, 1}, {-1, 0, 1, 1}}) ==
+		        Rect<float>{-1, 0, 3.5f, 3});
+
+		using Fx = Fixed<24, 8>;
+		REQUIRE(getHull(execution::seq, std::vector<Rect<Fx>>{{5, 5, 1, 1}}) == Rect<Fx>{5, 5, 1, 1});
+		REQUIRE(getHull(execution::seq, std::vector<Rect<Fx>>{{}, {5, 5, 1, 1}, {Fx(7.5), 6, 1, 1}}) ==
+		        Rect<Fx>{5, 5, Fx(3.5), 2});
+
+		const std::vector<Range<int>> ranges = {{10, 20}, {-5, 0}, {}, {15, 40}};
+		REQUIRE(getHull(execution::seq, ranges) == Range{-5, 40});
+		REQUIRE(getHull(par, ranges) == Range{-5, 40});
+		REQUIRE(getHull(execution::seq, std::vector<Range<Fx>>{{}, {5, 6}}) == Range<Fx>{5, 6});
+	}
+
+	SECTION("Test covered length")
+	{
+		std::vector<Range<int>> ranges;
+		std::vector<bool>       covered(2000, false);
+		for (int i = 0; i < 300; i++)
+		{
+			const int a = (i * 37) % 1900;
+			ranges.push_back({a, a + 1 + i % 40});
+			for (int j = a; j < a + 1 + i % 40; j++)
+				covered[j] = true;
+		}
+		const int expected = static_cast<int>(std::count(covered.begin(), covered.end(), true));
+
+		REQUIRE(getCoveredLength(execution::seq, ranges) == expected);
+		REQUIRE(getCoveredLength(execution::par.on(pool), ranges) == expected);
+		REQUIRE(getCoveredLength(execution::par.on(pool).withGrain(7), ranges) == expected);
+		REQUIRE(getCoveredLength(execution::seq, std::vector<Range<int>>{}) == 0);
+
+		// Fewer units than slabs, so that some slabs are empty.
+		const std::vector<Range<int>> narrow = {{0, 2}, {}, {1, 3}, {5, 6}};
+		REQUIRE(getCoveredLength(execution::par.on(pool).withGrain(1), narrow) == 4);
+	}
+
+	SECTION("Test union area")
+	{
+		std::vector<Rect<int>> small;
+		std::vector<bool>      covered(200 * 200, false);
+		for (int i = 0; i < 100; i++)
+		{
+			const Rect<int> r{(i * 37) % 180, (i * 91) % 180, 1 + i % 20, 1 + i % 13};
+			small.push_back(r);
+			for (int x = r.x; x < r.x + r.w; x++)
+				for (int y = r.y; y < r.y + r.h; y++)
+					covered[y * 200 + x] = true;
+		}
+		const auto expected = std::count(covered.begin(), covered.end(), true);
+
+		REQUIRE(getUnionArea(execution::seq, small) == expected);
+		REQUIRE(getUnionArea(execution::par.on(pool), small) == expected);
+		REQUIRE(getUnionArea(execution::par.on(pool).withGrain(7), small) == expected);
+		REQUIRE(getUnionArea(execution::par.on(pool).withGrain(1), std::vector<Rect<int>>{{0, 0, 2, 2}, {}, {1, 0, 2, 5}}) == 12);
+
+		const std::vector<Rect<double>> overlapping = {{0, 0, 2, 2}, {1, 1, 2, 2}};
+		REQUIRE(getUnionArea(execution::seq, overlapping) == 7.0);
+		REQUIRE(getUnionArea(execution::par.on(pool), overlapping) == 7.0);
+	}
+}
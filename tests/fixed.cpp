@@ -0,0 +1,140 @@
+#include "src/fixed.hpp"
+#include "src/border.hpp"
+#include "src/line.hpp"
+#include "src/point.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+TEST_CASE("Fixed")
+{
+	using namespace geompp;
+	using Fx = Fixed<24, 8>;
+
+	SECTION("Test conversions")
+	{
+		REQUIRE(Fx(3).getRaw() == 3 * 256);
+		REQUIRE(Fx(1.5f).getRaw() == 384);
+		REQUIRE(Fx(-1.5).getRaw() == -384);
+		REQUIRE(static_cast<int>(Fx(-1.75)) == -1);
+		REQUIRE(static_cast<double>(Fx(2.25)) == 2.25);
+	}
+
+	SECTION("Test arithmetic")
+	{
+		static_assert(Fx(2) * Fx(1.5) == Fx(3));
+		static_assert(Fx(3) / Fx(2) == Fx(1.5));
+		static_assert(Fx(1) + 2 == Fx(3));
+		static_assert(-Fx(1) < 0);
+
+		Fx f = 10;
+		f *= 0.5f;
+		f -= 1;
+		REQUIRE(f == 4);
+	}
+
+	SECTION("Test wrap around")
+	{
+		constexpr Fx MAX = std::numeric_limits<Fx>::max();
+		constexpr Fx MIN = std::numeric_limits<Fx>::lowest();
+
+		static_assert(MAX + Fx::fromRaw(1) == MIN);
+		static_assert(MIN - Fx::fromRaw(1) == MAX);
+		static_assert(-MIN == MIN);
+
+		using Fx16 = Fixed<8, 8>;
+		static_assert(std::numeric_limits<Fx16>::max() + Fx16::fromRaw(1) == std::numeric_limits<Fx16>::lowest());
+	}
+
+	SECTION("Test rounding modes")
+	{
+		const Fx a = Fx::fromRaw(3); // 3/256
+		const Fx h = 0.5;
+
+		REQUIRE(Fx::mul<Rounding::FLOOR>(a, h).getRaw() == 1);
+		REQUIRE(Fx::mul<Rounding::CEIL>(a, h).getRaw() == 2);
+		REQUIRE(Fx::mul<Rounding::NEAREST>(a, h).getRaw() == 2);
+		REQUIRE(Fx::mul<Rounding::TRUNC>(-a, h).getRaw() == -1);
+		REQUIRE(Fx::mul<Rounding::FLOOR>(-a, h).getRaw() == -2);
+		REQUIRE(Fx::mul<Rounding::NEAREST>(-a, h).getRaw() == -2);
+
+		REQUIRE(Fx::div<Rounding::FLOOR>(Fx(1), Fx(3)).getRaw() == 85);
+		REQUIRE(Fx::div<Rounding::CEIL>(Fx(1), Fx(3)).getRaw() == 86);
+		REQUIRE(Fx::div<Rounding::FLOOR>(Fx(-1), Fx(3)).getRaw() == -86);
+		REQUIRE(Fx::div<Rounding::TRUNC>(Fx(-1), Fx(3)).getRaw() == -85);
+
+		REQUIRE(Fx(2.5).toInt<Rounding::NEAREST>() == 3);
+		REQUIRE(Fx(-2.5).toInt<Rounding::NEAREST>() == -3);
+		REQUIRE(Fx(-2.5).toInt<Rounding::FLOOR>() == -3);
+		REQUIRE(Fx(-2.5).toInt<Rounding::CEIL>() == -2);
+	}
+
+	SECTION("Test geometry types")
+	{
+		const Point<Fx>  p{1.5, 2};
+		const Line<Fx>   l{p, p + Point<Fx>{1, 1}};
+		const Border<Fx> b{0.5};
+		Range<Fx>        r{1, 2.5};
+		Rect<Fx>         rect{0, 0, 10, 10};
+
+		REQUIRE(l.x2 == 2.5);
+		REQUIRE((r * 2) == Range<Fx>{2, 5});
+		REQUIRE(rect.reduced(b) == Rect<Fx>{0.5, 0.5, 9, 9});
+		REQUIRE(rect.contains(p));
+
+		rect.scale(0.25f);
+		REQUIRE(rect == Rect<Fx>{0, 0, 2.5, 2.5});
+	}
+
+	SECTION("Test batch scale")
+	{
+		std::vector<Rect<Fx>>  rects  = {{1, 2, 3, 4}, {10, 10, 0.5, 0.5}};
+		std::vector<Range<Fx>> ranges = {{1, 3}};
+
+		scale(rects, Fx(1.5));
+		scale<Rounding::FLOOR>(ranges, Fx(0.3));
+
+		REQUIRE(rects[0] == Rect<Fx>{1.5, 3, 4.5, 6});
+		REQUIRE(rects[1] == Rect<Fx>{15, 15, 0.75, 0.75});
+		REQUIRE(ranges[0].getA() == Fx::mul<Rounding::FLOOR>(1, Fx(0.3)));
+		REQUIRE(ranges[0].getB() == Fx::mul<Rounding::FLOOR>(3, Fx(0.3)));
+	}
+
+	SECTION("Test batch scale of degenerate Ranges")
+	{
+		const Fx ulp = Fx::fromRaw(1);
+
+		std::vector<Range<Fx>> ranges = {{ulp, Fx::fromRaw(2)}};
+		scale<Rounding::FLOOR>(ranges, Fx(0.3));
+		REQUIRE(ranges[0] == Range<Fx>{Fx(0), ulp});
+
+		ranges = {{1, 3}, {-2, 5}};
+		scale(ranges, Fx(0));
+		REQUIRE(ranges[0] == Range<Fx>{Fx(0), ulp});
+		REQUIRE(ranges[1] == Range<Fx>{Fx(0), ulp});
+
+		ranges = {{1, 3}, {-2, 5}};
+		scale(ranges, Fx(-1));
+		REQUIRE(ranges[0] == Range<Fx>{-3, -1});
+		REQUIRE(ranges[1] == Range<Fx>{-5, 2});
+
+		using Fx16 = Fixed<8, 8>;
+
+		std::vector<Range<Fx16>> ranges16(100, Range<Fx16>{Fx16::fromRaw(1), Fx16::fromRaw(2)});
+		scale<Rounding::FLOOR>(ranges16, Fx16(0.3));
+		for (const Range<Fx16>& r : ranges16)
+			REQUIRE(r == Range<Fx16>{Fx16(0), Fx16::fromRaw(1)});
+	}
+
+	SECTION("Test batch scale of degenerate Rects")
+	{
+		std::vector<Rect<Fx>> rects = {{1, 2, 3, 4}, {-1, -1, 2, 2}};
+
+		scale(rects, Fx(0));
+		REQUIRE(!rects[0].isValid());
+		REQUIRE(!rects[1].isValid());
+
+		rects = {{1, 2, 3, 4}};
+		scale(rects, Fx(-1));
+		REQUIRE(!rects[0].isValid());
+	}
+}
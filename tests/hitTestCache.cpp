@@ -0,0 +1,89 @@
+#include "src/fixed.hpp"
+#include "src/hitTestCache.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <vector>
+
+namespace
+{
+std::size_t bruteForce(const geompp::HitTestCache<int>& cache, geompp::Point<int> p)
+{
+	for (std::size_t i = cache.size(); i-- > 0;)
+		if (cache[i].contains(p))
+			return i;
+	return geompp::HitTestCache<int>::npos;
+}
+} // namespace
+
+TEST_CASE("HitTestCache")
+{
+	using namespace geompp;
+
+	HitTestCache<int> cache({{0, 0, 100, 100}, {20, 20, 10, 10}, {50, 0, 50, 50}});
+
+	SECTION("Test hit and safe rect")
+	{
+		REQUIRE(cache.hitTest({5, 5}) == 0);
+		REQUIRE(cache.getSafeRect().contains(Point{5, 5}));
+		REQUIRE(!cache.getSafeRect().intersects(cache[1]));
+		REQUIRE(!cache.getSafeRect().intersects(cache[2]));
+
+		REQUIRE(cache.hitTest({25, 25}) == 1);
+		REQUIRE(cache.getSafeRect() == cache[1]);
+
+		REQUIRE(cache.hitTest({60, 10}) == 2);
+		REQUIRE(cache.hitTest({200, 200}) == HitTestCache<int>::npos);
+		REQUIRE(!cache.getSafeRect().intersects(cache[0]));
+	}
+
+	SECTION("Test invalidation")
+	{
+		REQUIRE(cache.hitTest({5, 5}) == 0);
+		const Rect<int> safe = cache.getSafeRect();
+
+		cache.add({500, 500, 10, 10});
+		REQUIRE(cache.getSafeRect() == safe);
+
+		cache.add({0, 0, 10, 10});
+		REQUIRE(!cache.getSafeRect().isValid());
+		REQUIRE(cache.hitTest({5, 5}) == 4);
+
+		cache.remove(3);
+		REQUIRE(cache.hitTest({5, 5}) == 3);
+
+		cache.set(3, {300, 300, 10, 10});
+		REQUIRE(cache.hitTest({5, 5}) == 0);
+	}
+
+	SECTION("Test misses with Fixed")
+	{
+		using Fx = Fixed<24, 8>;
+
+		HitTestCache<Fx> fixed({{0, 0, 100, 100}, {Fx(150.5), 0, 50, 50}});
+
+		REQUIRE(fixed.hitTest({120, 10}) == HitTestCache<Fx>::npos);
+		REQUIRE(fixed.getSafeRect().isValid());
+		REQUIRE(fixed.getSafeRect().contains(Point<Fx>{Fx(120.5), 40}));
+		REQUIRE(!fixed.getSafeRect().intersects(fixed[0]));
+		REQUIRE(!fixed.getSafeRect().intersects(fixed[1]));
+	}
+
+	SECTION("Test pointer stream")
+	{
+		std::mt19937                       rng(42);
+		std::uniform_int_distribution<int> pos(0, 400), size(5, 80), step(-3, 3);
+
+		HitTestCache<int> widgets;
+		for (int i = 0; i < 50; i++)
+			widgets.add({pos(rng), pos(rng), size(rng), size(rng)});
+
+		Point<int> p{200, 200};
+		for (int i = 0; i < 5000; i++)
+		{
+			p = {p.x + step(rng), p.y + step(rng)};
+			if (i % 500 == 0)
+				widgets.set(i % widgets.size(), {p.x - 10, p.y - 10, 20, 20});
+			REQUIRE(widgets.hitTest(p) == bruteForce(widgets, p));
+		}
+	}
+}
@@ -0,0 +1,88 @@
+#include "src/predicates.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdint>
+
+TEST_CASE("Predicates")
+{
+	using namespace geompp;
+
+	SECTION("Test orientation")
+	{
+		REQUIRE(orient2d<int>({0, 0}, {10, 0}, {5, 5}) == 1);
+		REQUIRE(orient2d<int>({0, 0}, {10, 0}, {5, -5}) == -1);
+		REQUIRE(orient2d<int>({0, 0}, {10, 0}, {20, 0}) == 0);
+	}
+
+	SECTION("Test near-degenerate doubles")
+	{
+		// Points on a tiny grid around (0.5, 0.5), tested against the line
+		// y = x. The naive double expression gets many of these wrong.
+		const double        u = std::ldexp(1.0, -53);
+		const Point<double> q{12, 12}, r{24, 24};
+
+		for (int i = 0; i < 32; i++)
+			for (int j = 0; j < 32; j++)
+			{
+				const Point<double> p{0.5 + i * u, 0.5 + j * u};
+				const int           expected = (j > i) - (j < i);
+				REQUIRE(orient2d(p, q, r) == expected);
+				REQUIRE(orient2d(q, r, p) == expected);
+			}
+	}
+
+	SECTION("Test wide integers")
+	{
+		const std::int64_t        big = std::int64_t{1} << 62;
+		const Point<std::int64_t> a{-big, -big}, b{big, big};
+
+		REQUIRE(orient2d(a, b, {0, 1}) == 1);
+		REQUIRE(orient2d(a, b, {1, 0}) == -1);
+		REQUIRE(orient2d(a, b, {big / 2 + 1, big / 2 + 1}) == 0);
+		REQUIRE(orient2d(a, b, {big - 1, big}) == 1);
+	}
+
+	SECTION("Test 64-bit integers on every path")
+	{
+		/* Around 2^53 the double filter decides, around 2^60 the 128-bit one
+		(if any) and around 2^63 only expansions can. */
+
+		for (const int bits : {20, 52, 53, 60, 61, 62})
+		{
+			const std::int64_t        big = std::int64_t{1} << bits;
+			const Point<std::int64_t> a{-big, -big + 1}, b{big, big - 1};
+
+			REQUIRE(orient2d(a, b, {0, 0}) == 0);
+			REQUIRE(orient2d(a, b, {0, 1}) == 1);
+			REQUIRE(orient2d(a, b, {0, -1}) == -1);
+			REQUIRE(orient2d(a, b, {big - 1, big - 2}) == -1);
+			REQUIRE(orient2d(b, a, {big - 1, big - 2}) == 1);
+		}
+
+		const std::uint64_t        big = std::uint64_t{1} << 60;
+		const Point<std::uint64_t> a{0, 0}, b{big, big + 1};
+		REQUIRE(orient2d(a, b, {big - 1, big}) == 1);
+		REQUIRE(orient2d(a, b, {2 * big, 2 * big + 2}) == 0);
+	}
+
+	SECTION("Test point on segment")
+	{
+		const Line<float> l{0, 0, 4, 2};
+
+		REQUIRE(isOnSegment<float>({2, 1}, l));
+		REQUIRE(isOnSegment<float>({0, 0}, l));
+		REQUIRE(!isOnSegment<float>({6, 3}, l));
+		REQUIRE(!isOnSegment<float>({2, 1.0001f}, l));
+	}
+
+	SECTION("Test segment intersection")
+	{
+		const Line<int> l{0, 0, 10, 10};
+
+		REQUIRE(intersects(l, Line<int>{0, 10, 10, 0}));
+		REQUIRE(intersects(l, Line<int>{10, 10, 20, 0}));
+		REQUIRE(intersects(l, Line<int>{5, 5, 20, 20}));
+		REQUIRE(!intersects(l, Line<int>{11, 11, 20, 20}));
+		REQUIRE(!intersects(l, Line<int>{0, 1, 9, 10}));
+	}
+}
@@ -118,6 +118,13 @@ TEST_CASE("Range")
 		}
 	}
 
+	SECTION("Test union")
+	{
+		REQUIRE(r1.getUnion({20, 30}) == Range{0, 30});
+		REQUIRE(r1.getUnion({-5, 5}) == Range{-5, 10});
+		REQUIRE(r1.getUnion({}) == r1);
+	}
+
 	SECTION("Test operations (compound)")
 	{
 		auto rMult = r1;
@@ -0,0 +1,110 @@
+#include "src/rangeStream.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <vector>
+
+namespace
+{
+using Ranges = std::vector<geompp::Range<int>>;
+
+template <typename S>
+Ranges drain(S stream)
+{
+	Ranges out;
+	while (auto r = stream.next())
+		out.push_back(*r);
+	return out;
+}
+
+/* Brute-force reference: converts sorted, disjoint ranges to a coverage
+bitmap and back. */
+
+std::vector<bool> toBitmap(const Ranges& ranges)
+{
+	std::vector<bool> bits(300, false);
+	for (const auto& r : ranges)
+		for (int i = r.getA(); i < r.getB(); i++)
+			bits[i] = true;
+	return bits;
+}
+
+Ranges fromBitmap(const std::vector<bool>& bits)
+{
+	Ranges out;
+	for (int i = 0; i < static_cast<int>(bits.size()); i++)
+		if (bits[i] && (i == 0 || !bits[i - 1]))
+		{
+			int j = i;
+			while (j < static_cast<int>(bits.size()) && bits[j])
+				j++;
+			out.push_back({i, j});
+		}
+	return out;
+}
+
+Ranges makeSorted(std::mt19937& rng, int count)
+{
+	std::uniform_int_distribution<int> start(0, 250), length(1, 20);
+	Ranges                             out;
+	for (int i = 0; i < count; i++)
+	{
+		const int a = start(rng);
+		out.push_back({a, a + length(rng)});
+	}
+	std::sort(out.begin(), out.end(), [](const auto& l, const auto& r) { return l.getA() < r.getA(); });
+	return out;
+}
+} // namespace
+
+TEST_CASE("RangeStream")
+{
+	using namespace geompp;
+
+	std::mt19937 rng(42);
+
+	SECTION("Test merge and coalesce")
+	{
+		const Ranges r1 = {{0, 10}, {30, 40}}, r2 = {{5, 15}, {50, 60}}, r3 = {{15, 20}, {42, 45}};
+
+		MergeRangeStream merged(std::vector{SpanRangeStream<int>(r1), SpanRangeStream<int>(r2), SpanRangeStream<int>(r3)});
+		REQUIRE(drain(std::move(merged)) == Ranges{{0, 10}, {5, 15}, {15, 20}, {30, 40}, {42, 45}, {50, 60}});
+
+		CoalesceRangeStream coalesced(MergeRangeStream(std::vector{SpanRangeStream<int>(r1), SpanRangeStream<int>(r2), SpanRangeStream<int>(r3)}));
+		REQUIRE(drain(std::move(coalesced)) == Ranges{{0, 20}, {30, 40}, {42, 45}, {50, 60}});
+
+		CoalesceRangeStream tolerant(MergeRangeStream(std::vector{SpanRangeStream<int>(r1), SpanRangeStream<int>(r2), SpanRangeStream<int>(r3)}), 2);
+		REQUIRE(drain(std::move(tolerant)) == Ranges{{0, 20}, {30, 45}, {50, 60}});
+	}
+
+	SECTION("Test set operations")
+	{
+		for (int round = 0; round < 50; round++)
+		{
+			const Ranges a = makeSorted(rng, 12), b = makeSorted(rng, 12);
+			const Ranges ca = drain(CoalesceRangeStream(SpanRangeStream<int>(a)));
+			const Ranges cb = drain(CoalesceRangeStream(SpanRangeStream<int>(b)));
+
+			const std::vector<bool> ba = toBitmap(ca), bb = toBitmap(cb);
+			std::vector<bool>       bu(ba.size()), bi(ba.size()), bd(ba.size());
+			for (std::size_t i = 0; i < ba.size(); i++)
+			{
+				bu[i] = ba[i] || bb[i];
+				bi[i] = ba[i] && bb[i];
+				bd[i] = ba[i] && !bb[i];
+			}
+
+			REQUIRE(ca == fromBitmap(ba));
+			REQUIRE(drain(UnionRangeStream(SpanRangeStream<int>(a), SpanRangeStream<int>(b))) == fromBitmap(bu));
+			REQUIRE(drain(IntersectionRangeStream(SpanRangeStream<int>(ca), SpanRangeStream<int>(cb))) == fromBitmap(bi));
+			REQUIRE(drain(DifferenceRangeStream(SpanRangeStream<int>(ca), SpanRangeStream<int>(cb))) == fromBitmap(bd));
+		}
+	}
+
+	SECTION("Test composition")
+	{
+		const Ranges a = {{0, 100}}, b = {{10, 20}, {20, 30}, {50, 60}};
+
+		DifferenceRangeStream diff{SpanRangeStream<int>(a), CoalesceRangeStream(SpanRangeStream<int>(b))};
+		REQUIRE(drain(std::move(diff)) == Ranges{{0, 10}, {30, 50}, {60, 100}});
+	}
+}
@@ -0,0 +1,86 @@
+#include "src/rect.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+TEST_CASE("Rect")
+{
+	using namespace geompp;
+
+	const Rect r1{0, 0, 10, 10};
+
+	SECTION("Test difference")
+	{
+		SECTION("Test middle")
+		{
+			// r1: ----------
+			// r2:    ----
+			const Rect r2{3, 3, 4, 4};
+			const auto [top, bottom, left, right] = r1.getDifference(r2);
+
+			REQUIRE(top == Rect{0, 0, 10, 3});
+			REQUIRE(bottom == Rect{0, 7, 10, 3});
+			REQUIRE(left == Rect{0, 3, 3, 4});
+			REQUIRE(right == Rect{7, 3, 3, 4});
+		}
+
+		SECTION("Test left edge")
+		{
+			const Rect r2{-5, -5, 10, 20};
+			const auto [top, bottom, left, right] = r1.getDifference(r2);
+
+			REQUIRE(!top.isValid());
+			REQUIRE(!bottom.isValid());
+			REQUIRE(!left.isValid());
+			REQUIRE(right == Rect{5, 0, 5, 10});
+		}
+
+		SECTION("Test covered")
+		{
+			const Rect r2{-1, -1, 12, 12};
+			for (const Rect<int>& piece : r1.getDifference(r2))
+				REQUIRE(!piece.isValid());
+		}
+
+		SECTION("Test no intersection")
+		{
+			const Rect r2{20, 20, 5, 5};
+			const auto [top, bottom, left, right] = r1.getDifference(r2);
+
+			REQUIRE(top == r1);
+			REQUIRE(!bottom.isValid());
+			REQUIRE(!left.isValid());
+			REQUIRE(!right.isValid());
+		}
+
+		SECTION("Test area")
+		{
+			const Rect r2{4, -2, 3, 20};
+			int        area = r1.getIntersection(r2).w * r1.getIntersection(r2).h;
+			for (const Rect<int>& piece : r1.getDifference(r2))
+				if (piece.isValid())
+					area += piece.w * piece.h;
+			REQUIRE(area == r1.w * r1.h);
+		}
+	}
+
+	SECTION("Test subtract")
+	{
+		const std::vector<Rect<int>> rects = {{0, 0, 10, 10}, {20, 0, 10, 10}, {100, 100, 5, 5}};
+		std::vector<Rect<int>>       out(rects.size() * 4);
+
+		const std::size_t count = subtract(rects, Rect{5, 0, 20, 10}, out);
+
+		REQUIRE(count == 3);
+		REQUIRE(out[0] == Rect{0, 0, 5, 10});
+		REQUIRE(out[1] == Rect{25, 0, 5, 10});
+		REQUIRE(out[2] == Rect{100, 100, 5, 5});
+	}
+
+	SECTION("Test union")
+	{
+		REQUIRE(r1.getUnion({20, -5, 5, 5}) == Rect{0, -5, 25, 15});
+		REQUIRE(r1.getUnion({2, 2, 2, 2}) == r1);
+		REQUIRE(r1.getUnion({}) == r1);
+		REQUIRE(Rect<int>().getUnion(r1) == r1);
+	}
+}
@@ -0,0 +1,98 @@
+#include "src/serialization.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <vector>
+
+TEST_CASE("Serialization")
+{
+	using namespace geompp;
+
+	SECTION("Test Rect round trip")
+	{
+		const std::vector<Rect<int>> rects = {{0, 0, 10, 10}, {-5, 3, 2, 8}, {100, 200, 300, 400}};
+		std::vector<std::byte>       blob;
+		writeBinary<Rect<int>>(rects, blob);
+
+		REQUIRE(blob.size() == getBinarySize<Rect<int>>(rects.size()));
+
+		const BinaryView<Rect<int>> view(blob);
+
+		REQUIRE(view.isValid());
+		REQUIRE(view.size() == rects.size());
+		for (std::size_t i = 0; i < rects.size(); i++)
+			REQUIRE(view[i] == rects[i]);
+	}
+
+	SECTION("Test Range round trip")
+	{
+		const std::vector<Range<std::int64_t>> ranges = {{0, 10}, {10, 1LL << 40}};
+		std::vector<std::byte>                 blob;
+		writeBinary<Range<std::int64_t>>(ranges, blob);
+
+		const BinaryView<Range<std::int64_t>> view(blob);
+
+		REQUIRE(view.isValid());
+		REQUIRE(view.size() == ranges.size());
+		REQUIRE(view[1] == ranges[1]);
+	}
+
+	SECTION("Test StaticRangeMap round trip")
+	{
+		std::vector<Range<std::int64_t>> ranges;
+		for (std::int64_t i = 0; i < 100; i++)
+			ranges.push_back({i * 10, i * 10 + 1 + i % 9});
+
+		const StaticRangeMap<std::int64_t> map(ranges);
+		std::vector<std::byte>             blob;
+		writeBinary(map, blob);
+
+		REQUIRE(blob.size() == getBinarySize(map));
+
+		const StaticRangeMapView<std::int64_t> view(blob);
+
+		REQUIRE(view.isValid());
+		REQUIRE(view.size() == map.size());
+		for (std::int64_t t = -5; t < 1010; t++)
+		{
+			REQUIRE(view.findIndex(t) == map.findIndex(t));
+			REQUIRE(view.find(t) == (map.find(t) ? *map.find(t) : Range<std::int64_t>()));
+		}
+
+		REQUIRE(!StaticRangeMapView<std::int32_t>(blob).isValid());
+		REQUIRE(!BinaryView<Range<std::int64_t>>(blob).isValid());
+		REQUIRE(!StaticRangeMapView<std::int64_t>(std::span(blob).first(blob.size() - 1)).isValid());
+
+		std::vector<std::byte> empty;
+		writeBinary(StaticRangeMap<std::int64_t>(), empty);
+		REQUIRE(StaticRangeMapView<std::int64_t>(empty).isValid());
+		REQUIRE(StaticRangeMapView<std::int64_t>(empty).findIndex(0) == StaticRangeMapView<std::int64_t>::npos);
+	}
+
+	SECTION("Test little-endian layout")
+	{
+		const std::vector<Point<std::int32_t>> points = {{0x01020304, -1}};
+		std::vector<std::byte>                 blob;
+		writeBinary<Point<std::int32_t>>(points, blob);
+
+		REQUIRE(blob[32] == std::byte{0x04});
+		REQUIRE(blob[35] == std::byte{0x01});
+	}
+
+	SECTION("Test invalid blobs")
+	{
+		const std::vector<Line<float>> lines = {{0, 0, 1, 1}, {2, 2, 3, 3}};
+		std::vector<std::byte>         blob;
+		writeBinary<Line<float>>(lines, blob);
+
+		REQUIRE(BinaryView<Line<float>>(blob).isValid());
+		REQUIRE(!BinaryView<Line<double>>(blob).isValid());
+		REQUIRE(!BinaryView<Rect<float>>(blob).isValid());
+
+		blob.pop_back();
+		REQUIRE(!BinaryView<Line<float>>(blob).isValid());
+		REQUIRE(BinaryView<Line<float>>(blob).size() == 0);
+
+		blob[0] = std::byte{'X'};
+		REQUIRE(!BinaryView<Line<float>>(std::span(blob).first(40)).isValid());
+	}
+}
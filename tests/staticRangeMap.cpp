@@ -0,0 +1,115 @@
+#include "src/staticRangeMap.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+TEST_CASE("StaticRangeMap")
+{
+	using namespace geompp;
+
+	SECTION("Test empty")
+	{
+		const StaticRangeMap<int> map;
+		REQUIRE(map.findIndex(0) == StaticRangeMap<int>::npos);
+		REQUIRE(map.find(0) == nullptr);
+	}
+
+	SECTION("Test lookup")
+	{
+		// Ranges of growing length with gaps in between.
+		std::vector<Range<std::int64_t>> ranges;
+		std::int64_t                     a = -100;
+		for (std::int64_t i = 0; i < 1000; i++)
+		{
+			const std::int64_t length = 1 + i % 7;
+			const std::int64_t gap    = i % 3;
+			ranges.push_back({a, a + length});
+			a += length + gap;
+		}
+
+		const StaticRangeMap<std::int64_t> map(ranges);
+		REQUIRE(map.size() == ranges.size());
+
+		for (std::int64_t t = -110; t < a + 10; t++)
+		{
+			std::size_t expected = StaticRangeMap<std::int64_t>::npos;
+			for (std::size_t i = 0; i < ranges.size(); i++)
+				if (ranges[i].contains(t))
+					expected = i;
+
+			REQUIRE(map.findIndex(t) == expected);
+		}
+	}
+
+	SECTION("Test find")
+	{
+		const std::vector<Range<int>> ranges = {{0, 10}, {10, 20}, {30, 40}};
+		const StaticRangeMap<int>     map(ranges);
+
+		REQUIRE(*map.find(10) == ranges[1]);
+		REQUIRE(*map.find(39) == ranges[2]);
+		REQUIRE(map.find(25) == nullptr);
+		REQUIRE(map.find(40) == nullptr);
+		REQUIRE(map.find(-1) == nullptr);
+	}
+
+	SECTION("Test parallel build")
+	{
+		ThreadPool pool(3);
+
+		for (const int n : {0, 1, 2, 7, 15, 16, 17, 100, 1000, 5000})
+		{
+			std::vector<Range<int>> ranges;
+			for (int i = 0; i < n; i++)
+				ranges.push_back({i * 4, i * 4 + 3});
+
+			const StaticRangeMap<int> map(execution::par.on(pool), ranges);
+			REQUIRE(map.size() == ranges.size());
+
+			for (int t = -1; t <= n * 4; t++)
+				REQUIRE(map.findIndex(t) == (t >= 0 && t % 4 != 3 && t < n * 4 ? static_cast<std::size_t>(t / 4) : StaticRangeMap<int>::npos));
+		}
+	}
+
+	SECTION("Test copy")
+	{
+		const std::vector<Range<int>> ranges = {{0, 10}, {10, 20}, {30, 40}, {40, 45}, {50, 60}, {60, 61}, {70, 80}};
+
+		auto                original = std::make_unique<StaticRangeMap<int>>(ranges);
+		StaticRangeMap<int> copy(*original);
+		StaticRangeMap<int> assigned;
+		assigned = *original;
+		original.reset();
+
+		for (const StaticRangeMap<int>* map : {&copy, &assigned})
+		{
+			for (std::size_t i = 0; i < ranges.size(); i++)
+				REQUIRE(map->findIndex(ranges[i].getA()) == i);
+			REQUIRE(map->find(25) == nullptr);
+
+			/* The root, i.e. the median Range, follows a cache line boundary. */
+
+			const auto root = reinterpret_cast<std::uintptr_t>(map->find(40));
+			REQUIRE((root - sizeof(Range<int>)) % 64 == 0);
+		}
+
+		const StaticRangeMap<int> empty;
+		const StaticRangeMap<int> emptyCopy(empty);
+		REQUIRE(emptyCopy.find(0) == nullptr);
+
+		/* Moving leaves the source empty but usable. */
+
+		StaticRangeMap<int> moved(std::move(copy));
+		REQUIRE(moved.findIndex(40) == 3);
+		REQUIRE(copy.size() == 0);
+		REQUIRE(copy.findIndex(5) == StaticRangeMap<int>::npos);
+		REQUIRE(copy.find(5) == nullptr);
+
+		assigned = std::move(moved);
+		REQUIRE(assigned.findIndex(5) == 0);
+		REQUIRE(moved.findIndex(5) == StaticRangeMap<int>::npos);
+		REQUIRE(StaticRangeMap<int>(moved).size() == 0);
+	}
+}
@@ -0,0 +1,134 @@
+#include "src/algorithms.hpp"
+#include "src/hitTestCache.hpp"
+#include "src/staticRangeMap.hpp"
+#include "src/stats.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static_assert(GEOMPP_STATS, "tests/stats.cpp must be built with GEOMPP_STATS=1");
+
+TEST_CASE("Stats")
+{
+	using namespace geompp;
+
+	resetStats();
+
+	SECTION("Test reset")
+	{
+		GEOMPP_STATS_ADD(nodesVisited, 3);
+		REQUIRE(getStats().nodesVisited == 3);
+
+		resetStats();
+		REQUIRE(getStats().nodesVisited == 0);
+	}
+
+	SECTION("Test nodesVisited")
+	{
+		std::vector<Range<int>> ranges;
+		for (int i = 0; i < 1000; i++)
+			ranges.push_back({i * 10, i * 10 + 5});
+
+		const StaticRangeMap<int> map(ranges);
+		REQUIRE(map.findIndex(5003) == 500);
+
+		// One node per level of a 1000 nodes tree.
+		REQUIRE(getStats().nodesVisited >= 9);
+		REQUIRE(getStats().nodesVisited <= 10);
+	}
+
+	SECTION("Test candidatesTested")
+	{
+		const std::vector<Rect<int>> rects = {{0, 0, 10, 10}, {20, 0, 10, 10}, {40, 0, 10, 10}};
+		std::vector<Rect<int>>       out(rects.size());
+
+		REQUIRE(cull(execution::seq, rects, Rect<int>{0, 0, 25, 5}, out) == 2);
+		REQUIRE(getStats().candidatesTested == 3);
+
+		HitTestCache<int> cache(rects);
+		cache.hitTest({5, 5});
+		cache.hitTest({6, 6}); // Served by the safe rect
+		REQUIRE(getStats().candidatesTested == 6);
+	}
+
+	SECTION("Test allocations")
+	{
+		const std::vector<Range<int>> ranges = {{0, 10}, {5, 20}, {30, 40}};
+		REQUIRE(getCoveredLength(execution::seq, ranges) == 30);
+		REQUIRE(getStats().allocations == 1);
+	}
+
+	SECTION("Test simdPaths and scalarPaths")
+	{
+		const std::vector<Rect<float>> valid   = {{0, 0, 10, 10}, {20, 0, 10, 10}, {40, 0, 10, 10}};
+		const std::vector<Rect<float>> invalid = {{0, 0, 10, 10}, {}, {40, 0, 10, 10}};
+
+		REQUIRE(getHull(execution::seq, valid) == Rect<float>{0, 0, 50, 10});
+		REQUIRE(getHull(execution::seq, invalid) == Rect<float>{0, 0, 50, 10});
+		REQUIRE(getHull(execution::seq, std::vector<Rect<Fixed<24, 8>>>{{0, 0, 1, 1}}).isValid());
+
+		// Only all-valid float Rects can take the vectorized path.
+		REQUIRE(getStats().simdPaths == (GEOMPP_VECTOR_EXTENSIONS ? 1 : 0));
+		REQUIRE(getStats().scalarPaths == (GEOMPP_VECTOR_EXTENSIONS ? 2 : 3));
+	}
+
+	SECTION("Test counters are per thread")
+	{
+		std::thread([] { GEOMPP_STATS_ADD(nodesVisited, 1); }).join();
+		REQUIRE(getStats().nodesVisited == 0);
+	}
+}
+
+TEST_CASE("ChromeTraceWriter")
+{
+	using namespace geompp;
+
+	std::ostringstream out;
+	{
+		ChromeTraceWriter writer(out);
+		setTraceCallback(std::ref(writer));
+
+		{
+			GEOMPP_TRACE_SCOPE("outer");
+			GEOMPP_TRACE_SCOPE("inner");
+		}
+		std::thread([] { GEOMPP_TRACE_SCOPE("worker"); }).join();
+
+		setTraceCallback({});
+	}
+
+	const std::string json = out.str();
+
+	SECTION("Test format")
+	{
+		REQUIRE(json.starts_with("[\n{"));
+		REQUIRE(json.ends_with("}\n]\n"));
+		REQUIRE(json.find(R"({"name":"inner","ph":"X","pid":0,"tid":0,"ts":)") != std::string::npos);
+		REQUIRE(json.find(R"(,"dur":)") != std::string::npos);
+	}
+
+	SECTION("Test order")
+	{
+		// Scopes are reported when they end, innermost first.
+		REQUIRE(json.find(R"("name":"inner")") < json.find(R"("name":"outer")"));
+		REQUIRE(json.find(R"("name":"outer")") < json.find(R"("name":"worker")"));
+	}
+
+	SECTION("Test thread ids")
+	{
+		REQUIRE(json.find(R"({"name":"outer","ph":"X","pid":0,"tid":0,)") != std::string::npos);
+		REQUIRE(json.find(R"({"name":"worker","ph":"X","pid":0,"tid":1,)") != std::string::npos);
+	}
+
+	SECTION("Test disabled")
+	{
+		std::ostringstream empty;
+		{
+			ChromeTraceWriter writer(empty);
+			GEOMPP_TRACE_SCOPE("ignored");
+		}
+		REQUIRE(empty.str() == "[\n]\n");
+	}
+}